@@ -20,84 +20,134 @@
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/geometry.h>
 
-using std::minstd_rand;
+#include "../common/BatchRandom.h"
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Random.h"
+#include "../common/Shard.h"
+
 using std::uniform_int_distribution;
 using std::uniform_real_distribution;
 using namespace ogdf;
 
 //! Creates a Norros-Reittu Graph. 
 /**
- * @param G is assigned the generated graph.
+ * @param sink is assigned the generated graph.
  * @param weights is degree sequence of Graph.
  */
-void norrosReittuGraph(Graph &G, Array<int> &weights) {
-	G.clear();
-	if (weights.size() == 0) return;
+void norrosReittuGraph(EdgeSink &sink, const Array<int> &weights) {
+	int n = weights.size();
+	if (n == 0) {
+		sink.finish();
+		return;
+	}
 
-	minstd_rand rng(randomSeed());
-	uniform_real_distribution<> dist(0, 1);
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
 
 	int Wk = 0;
 
 	// adding n nodes to graph and summing degree sequence
-	for (int i = 0; i < weights.size(); i++) {
-		G.newNode();
+	sink.reserve(n, 0);
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
 		Wk += weights[i];
 	}
 
-	int i, j;
-	node v, w;
-	for (i = 0, v = G.firstNode(); v; v = v->succ(), i++) {
-		for (j = i + 1, w = v->succ(); w; w = w->succ(), j++) {
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	// the pairs {i, j}, j > i, are decided by block i of stream 1
+	for (int i = rows.first; i < rows.second; i++) {
+		BatchRandom random(seed, 1, i);
+		probe.pairs(n - i - 1);
+		for (int j = i + 1; j < n; j++) {
 			double probability = 1.0 - exp(-(weights[i] * weights[j]) / (double)Wk);
-			if (dist(rng) < (probability + std::numeric_limits<double>::epsilon())) {
-				G.newEdge(v, w);
+			if (random.next() < (probability + std::numeric_limits<double>::epsilon())) {
+				sink.addEdge(i, j);
+				probe.edges();
 			}
 		}
 	}
 
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
 }
 
-//! Creates a Norros-Reittu Graph with random degree sequence. 
+//! Creates a Norros-Reittu Graph. 
 /**
  * @param G is assigned the generated graph.
+ * @param weights is degree sequence of Graph.
+ */
+void norrosReittuGraph(Graph &G, Array<int> &weights) {
+	G.clear();
+	GraphSink sink(G);
+	norrosReittuGraph(sink, weights);
+}
+
+//! Creates a Norros-Reittu Graph with random degree sequence. 
+/**
+ * @param sink is assigned the generated graph.
  * @param n is the number of nodes of the generated graph.
  */
-void norrosReittuRandomWeightsGraph(Graph &G, int n) {
+void norrosReittuRandomWeightsGraph(EdgeSink &sink, int n) {
 	OGDF_ASSERT(n >= 0);
 
-	G.clear();
-	if (n == 0) return;
+	if (n == 0) {
+		sink.finish();
+		return;
+	}
 
-	minstd_rand rng(randomSeed());
-	uniform_real_distribution<> dist(0, 1);
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
+	BatchRandom weightRandom(seed, 0, 0);
 
-	NodeArray<double> weights(G, 0.0);
+	Array<double> weights(n);
 	double Wk = 0.0;
 
 	// adding n nodes to graph
+	sink.reserve(n, 0);
 	for (int i = 0; i < n; i++) {
-		G.newNode();
+		sink.addNode();
 	}
 
 	// summing degree sequence
-	for (node v : G.nodes) {
-		weights[v] = dist(rng);
-		Wk += weights[v];
+	for (int i = 0; i < n; i++) {
+		weights[i] = weightRandom.next();
+		Wk += weights[i];
 	}
 
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
-			double probability = 1.0 - exp(-(weights[v] * weights[w]) / Wk);
-			if (dist(rng) <= (probability + std::numeric_limits<double>::epsilon())) {
-				G.newEdge(v, w);
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	// the pairs {i, j}, j > i, are decided by block i of stream 1
+	for (int i = rows.first; i < rows.second; i++) {
+		BatchRandom random(seed, 1, i);
+		probe.pairs(n - i - 1);
+		for (int j = i + 1; j < n; j++) {
+			double probability = 1.0 - exp(-(weights[i] * weights[j]) / Wk);
+			if (random.next() <= (probability + std::numeric_limits<double>::epsilon())) {
+				sink.addEdge(i, j);
+				probe.edges();
 			}
 		}
 	}
 
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Norros-Reittu Graph with random degree sequence. 
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ */
+void norrosReittuRandomWeightsGraph(Graph &G, int n) {
+	G.clear();
+	GraphSink sink(G);
+	norrosReittuRandomWeightsGraph(sink, n);
 }
 
 
+#ifndef OGDF_GENERATORS_LIBRARY
 int main(){
 	//! TODO: tests
 	Graph G;
@@ -108,7 +158,8 @@ int main(){
 		x = 4;
 	}
 
-	norrosReittuGraph(G, 10, weights);
+	norrosReittuGraph(G, weights);
 
 	return 0;
 }
+#endif
@@ -16,17 +16,163 @@
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <string>
+#include <vector>
 
 #include <ogdf/basic/Graph.h> 
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/basic/graph_generators.h>
 
-using std::minstd_rand;
+#include "../common/Checkpoint.h"
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Random.h"
+
 using std::uniform_int_distribution;
 using std::uniform_real_distribution;
 using namespace ogdf;
 
+//! Adds \p n nodes with \p d preferentially attached edges each to \p sink.
+/**
+ * With a \p checkpoint, the endpoints chosen for every new node are kept,
+ * and the run continues from the last checkpoint of the same run: the nodes
+ * and edges it holds are written to \p sink again and the random number
+ * engine is restored, so the output equals that of an uninterrupted run.
+ *
+ * @param sink already contains the initial graph.
+ * @param degree holds the degrees of the initial nodes and room for the new ones.
+ * @param numberOfEdges is the number of edges of the initial graph.
+ * @param n is the number of nodes to be added to graph.
+ * @param d is the minimum degree of new node.
+ * @param probe records the statistics of the calling generator.
+ * @param checkpoint saves the state periodically, or is nullptr.
+ */
+static void attachNodes(EdgeSink &sink, Array<int> &degree, long long numberOfEdges, int n, int d, GeneratorProbe &probe,
+		Checkpoint *checkpoint = nullptr) {
+	RandomEngine rng(generatorSeed());
+	uniform_real_distribution<> dist(0, 1);
+
+	Array<int> neighbors(d);
+	int start = 0;
+	std::vector<int> targets;
+
+	if (checkpoint != nullptr) {
+		std::string parameters = "n=" + std::to_string(n) + " d=" + std::to_string(d)
+			+ " initial=" + std::to_string(degree.size() - n) + "," + std::to_string(numberOfEdges);
+		// the next node followed by the state of the random number engine
+		std::vector<uint64_t> scalars(1 + RandomEngine::stateSize, 0);
+		if (checkpoint->resume("preferentialAttachmentGraph", parameters, {&targets}, scalars)) {
+			start = (int)scalars[0];
+			OGDF_ASSERT(start <= n && targets.size() == (size_t)start * d);
+			rng.setState(&scalars[1]);
+		}
+		targets.reserve((size_t)n * d);
+
+		// replaying the nodes restored from the checkpoint
+		for (int i = 0; i < start; i++) {
+			int w = sink.addNode();
+			for (int j = 0; j < d; j++) {
+				int v = targets[(size_t)i * d + j];
+				sink.addEdge(v, w);
+				probe.edges();
+				degree[v]++;
+				degree[w]++;
+				numberOfEdges++;
+			}
+		}
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	for (int i = start; i < n; i++) {
+		int w = sink.addNode();
+		uniform_int_distribution<> chooseNode(0, w);
+
+		while (degree[w] < d) {
+			int v = chooseNode(rng);
+			probe.pairs();
+			if (v != w && std::find(neighbors.begin(), neighbors.begin() + degree[w], v) == neighbors.begin() + degree[w]) {
+				double probability = (degree[v] / (double)(2 * numberOfEdges));
+				if (dist(rng) < (probability + std::numeric_limits<double>::epsilon())) {
+					sink.addEdge(v, w);
+					probe.edges();
+					neighbors[degree[w]] = v;
+					degree[v]++;
+					degree[w]++;
+					numberOfEdges++;
+					continue;
+				}
+			}
+			probe.rejections();
+		}
+
+		if (checkpoint != nullptr) {
+			targets.insert(targets.end(), neighbors.begin(), neighbors.begin() + d);
+			if (checkpoint->due()) {
+				checkpoint->save({{targets.data(), targets.size()}}, {(uint64_t)i + 1, rng.state(0), rng.state(1), rng.state(2), rng.state(3)});
+			}
+		}
+	}
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Adds the complete graph on \p d + 1 nodes to \p sink and returns the degrees for attachNodes().
+static Array<int> completeStart(EdgeSink &sink, int n, int d, GeneratorProbe &probe) {
+	sink.reserve(d + 1 + n, (long long)d * (d + 1) / 2 + (long long)n * d);
+
+	Array<int> degree(d + 1 + n);
+	for (int v = 0; v <= d; v++) {
+		sink.addNode();
+		degree[v] = d;
+		for (int w = 0; w < v; w++) {
+			sink.addEdge(w, v);
+			probe.edges();
+		}
+	}
+	for (int v = d + 1; v < degree.size(); v++) {
+		degree[v] = 0;
+	}
+	return degree;
+}
+
+//! Creates a Preferential Attachment Graph. 
+/**
+ * Starts with a complete graph on \p d + 1 nodes.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes to be added to graph.
+ * @param d is the minimum degree of new node.
+ */
+void preferentialAttachmentGraph(EdgeSink &sink, int n, int d) {
+	OGDF_ASSERT(1 <= d);
+
+	GeneratorProbe probe;
+	Array<int> degree = completeStart(sink, n, d, probe);
+	attachNodes(sink, degree, (long long)d * (d + 1) / 2, n, d, probe);
+}
+
+//! Creates a Preferential Attachment Graph, resuming from and saving to \p checkpoint.
+/**
+ * Starts with a complete graph on \p d + 1 nodes. If \p checkpoint holds
+ * a checkpoint of a run with the same \p n and \p d, the graph written to
+ * \p sink equals the one of that run, whatever seed is active now.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes to be added to graph.
+ * @param d is the minimum degree of new node.
+ * @param checkpoint is the checkpoint file to resume from and save to.
+ * \throws CheckpointMismatch if the file of \p checkpoint holds anything but a checkpoint of this run.
+ */
+void preferentialAttachmentGraph(EdgeSink &sink, int n, int d, Checkpoint &checkpoint) {
+	OGDF_ASSERT(1 <= d);
+
+	GeneratorProbe probe;
+	Array<int> degree = completeStart(sink, n, d, probe);
+	attachNodes(sink, degree, (long long)d * (d + 1) / 2, n, d, probe, &checkpoint);
+}
+
 //! Creates a Preferential Attachment Graph. 
 /**
 * @param G is assigned the generated graph.
@@ -36,23 +182,21 @@ using namespace ogdf;
 void preferentialAttachmentGraph(Graph &G, int n, int d) {
 	OGDF_ASSERT(1 <= d && d <= G.numberOfNodes());
 
-	minstd_rand rng(randomSeed());
-	uniform_real_distribution<> dist(0, 1);
-
-	for (int i = 0; i < n; i++) {
-		node w = G.newNode();
-		while (w->degree() < d) {
-			node v = G.chooseNode();
-			if (v != w && G.searchEdge(w,v) == nullptr) {
-				double probability = (v->degree() / (double)(2 * G.numberOfEdges()));
-				if (dist(rng) < (probability + std::numeric_limits<double>::epsilon())) {
-					G.newEdge(v, w);
-				}
-			}
-		}
+	GeneratorProbe probe;
+	Array<int> degree(G.numberOfNodes() + n);
+	int i = 0;
+	for (node v : G.nodes) {
+		degree[i++] = v->degree();
+	}
+	for (; i < degree.size(); i++) {
+		degree[i] = 0;
 	}
+
+	GraphSink sink(G);
+	attachNodes(sink, degree, G.numberOfEdges(), n, d, probe);
 }
 
+#ifndef OGDF_GENERATORS_LIBRARY
 int main(){
 	//! TODO: tests
 	Graph G;
@@ -64,3 +208,4 @@ int main(){
 
 	return 0;
 }
+#endif
@@ -11,40 +11,55 @@
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <unordered_set>
 
 #include <ogdf/basic/Graph.h> 
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/geometry.h>
+#include <ogdf/basic/ArrayBuffer.h>
 #include <ogdf/basic/graph_generators.h>
 
-using std::minstd_rand;
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Random.h"
+
 using std::uniform_int_distribution;
 using std::uniform_real_distribution;
 using namespace ogdf;
 
 //! Creates a Watts-Strogatz Graph. 
 /**
- * @param G is assigned the generated graph.
+ * @param sink is assigned the generated graph.
  * @param n is the number of nodes 
  * @param d is the minimum degree.
  * @param probability is probability of rewiring
  */
-void randomWattsStrogatzGraph(Graph &G, int n, int k, double probability) {
+void randomWattsStrogatzGraph(EdgeSink &sink, int n, int k, double probability) {
 	
 	//! Atleast 3 nodes are required to make a ring
 	OGDF_ASSERT(n > 2);
 	OGDF_ASSERT(0 <= k && k <= n/2);
 	OGDF_ASSERT(0 < probability + std::numeric_limits<double>::epsilon() && probability < 1);
-	G.clear();
 
-	minstd_rand rng(randomSeed());
+	GeneratorProbe probe;
+	RandomEngine rng(generatorSeed());
 	uniform_real_distribution<> dist(0, 1);
+	uniform_int_distribution<> chooseNode(0, n - 1);
 
-	Array<node> v(n);
+	sink.reserve(n, (long long)n * k);
 	for (int i = 0; i < n; i++) {
-		v[i] = G.newNode();
+		sink.addNode();
 	}
 
+	//! edges as pairs of node indices and the set of adjacent pairs
+	ArrayBuffer<std::pair<int, int>, long long> edges((long long)n * k);
+	std::unordered_set<long long> adjacent;
+	adjacent.reserve((size_t)n * k);
+
+	auto key = [n](int u, int v) {
+		return (long long)std::min(u, v) * n + std::max(u, v);
+	};
+
 	for (int i = 0; i < n; i++) {
 		for (int j = 1; j <= k; j++) {
 			
@@ -52,40 +67,66 @@ void randomWattsStrogatzGraph(Graph &G, int n, int k, double probability) {
 			int t = ((i - j) % n) < 0 ? (n + ((i - j) % n)) : ((i - j) % n);
 				 
 			//! no new edge exist between (v, w) and v!=w then make a edge between them
-			if (G.searchEdge(v[i], v[t]) == nullptr && v[i] != v[t]) {
-				G.newEdge(v[i], v[t]);
+			if (i != t && adjacent.insert(key(i, t)).second) {
+				edges.push(std::make_pair(i, t));
 			}
 
-			if (G.searchEdge(v[i], v[(i + j) % n]) == nullptr && v[i] != v[(i + j) % n]) {
-				G.newEdge(v[i], v[(i + j) % n]);
+			if (i != (i + j) % n && adjacent.insert(key(i, (i + j) % n)).second) {
+				edges.push(std::make_pair(i, (i + j) % n));
 			}
 		}
 	}
 
-	edge f;
-	for (edge e = G.firstEdge(); e; e = f) {
-		f = e->succ();
-		node u = e->source();
-		node v = G.chooseNode();
+	//! every edge of the ring lattice is considered for rewiring once
+	probe.phase(GeneratorStats::Phase::Edges);
+	for (long long e = 0; e < edges.size(); e++) {
+		int u = edges[e].first;
+		int v = chooseNode(rng);
+		probe.pairs();
 
 		//! Choose a node until u != v
 		while (u == v) {
-			v = G.chooseNode();
+			v = chooseNode(rng);
+			probe.rejections();
 		}
 		
 		//! If there already exists edge between (u, v) ignore and continue
-		if (G.searchEdge(u, v) == nullptr) {
+		if (adjacent.count(key(u, v)) > 0) {
+			probe.rejections();
 			continue;
 		}
 		else {
 			if (dist(rng) < (probability + std::numeric_limits<double>::epsilon())) {
-				G.delEdge(e);
-				G.newEdge(u, v);
+				adjacent.erase(key(u, edges[e].second));
+				adjacent.insert(key(u, v));
+				edges[e].second = v;
 			}
 		}
 	}
+
+	for (long long e = 0; e < edges.size(); e++) {
+		sink.addEdge(edges[e].first, edges[e].second);
+	}
+	probe.edges(edges.size());
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Watts-Strogatz Graph. 
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes 
+ * @param d is the minimum degree.
+ * @param probability is probability of rewiring
+ */
+void randomWattsStrogatzGraph(Graph &G, int n, int k, double probability) {
+	G.clear();
+	GraphSink sink(G);
+	randomWattsStrogatzGraph(sink, n, k, probability);
 }
 
+#ifndef OGDF_GENERATORS_LIBRARY
 int main(){
 	//! TODO: tests
 	Graph G;
@@ -94,3 +135,4 @@ int main(){
 
 	return 0;
 }
+#endif
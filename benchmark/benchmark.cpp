@@ -0,0 +1,303 @@
+/** \file
+ * \brief Benchmark of all random graph generators.
+ *
+ * Runs every generator for n = 10^minExponent, ..., 10^maxExponent and
+ * prints one JSON document with the throughput, the peak resident set size,
+ * the number of random numbers drawn per edge and the GeneratorStats of each
+ * run. Every run is
+ * executed in a child process of its own, so the peak memory of one run does
+ * not hide that of the next and a run that exceeds the time limit can be
+ * stopped.
+ *
+ * Usage: generators-benchmark [--min-exponent 3] [--max-exponent 7]
+ *   [--generators name,name,...] [--sink count|csr|compressed|graph|statistics]
+ *   [--seed 1] [--timeout 60] [--max-pairs 2e9] [--output results.json]
+ *
+ * Generators that examine all pairs of nodes are skipped if n(n-1)/2
+ * exceeds --max-pairs.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <ogdf/basic/Graph.h>
+
+#include "../common/CompressedGraph.h"
+#include "../common/EdgeSink.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Generators.h"
+#include "../common/Random.h"
+#include "../common/StatisticsSink.h"
+
+using namespace ogdf;
+
+namespace {
+
+//! A generator and the parameters it is benchmarked with, which keep the average degree between 3 and about 10 for every n.
+struct Generator {
+	const char *name;
+	//! True if the generator examines all pairs of nodes.
+	bool quadratic;
+	std::function<void(EdgeSink &, int)> run;
+};
+
+Array<int> constantWeights(int n, int weight) {
+	Array<int> weights(n);
+	for (int &w : weights) {
+		w = weight;
+	}
+	return weights;
+}
+
+std::vector<Generator> generators() {
+	// Waxman parameters giving an average degree of roughly 10
+	auto planeAlpha = [](int n) { return std::min(1.0, 80.0 / n); };
+	auto modelTwoAlpha = [](int n) { return std::min(1.0, 100.0 / n); };
+	// a geometric threshold giving an average degree of 10, as pi r^2 n = 10
+	auto geometricThreshold = [](int n) { return std::sqrt(10.0 / (M_PI * std::max(n, 1))); };
+
+	return {
+		{ "randomChungLuGraph", true, [](EdgeSink &sink, int n) { randomChungLuGraph(sink, constantWeights(n, 10)); } },
+		{ "randomChungLuRandomWeightsGraph", true, [](EdgeSink &sink, int n) { randomChungLuRandomWeightsGraph(sink, n); } },
+		{ "norrosReittuGraph", true, [](EdgeSink &sink, int n) { norrosReittuGraph(sink, constantWeights(n, 10)); } },
+		{ "norrosReittuRandomWeightsGraph", true, [](EdgeSink &sink, int n) { norrosReittuRandomWeightsGraph(sink, n); } },
+		{ "preferentialAttachmentGraph", true, [](EdgeSink &sink, int n) { preferentialAttachmentGraph(sink, std::max(n - 6, 0), 5); } },
+		{ "randomBipartitePrefrentialGraph", false, [](EdgeSink &sink, int n) { randomBipartitePrefrentialGraph(sink, std::max(n / 10, 5), 5); } },
+		{ "randomWattsStrogatzGraph", false, [](EdgeSink &sink, int n) { randomWattsStrogatzGraph(sink, n, 10, 0.1); } },
+		{ "randomRegularGraph", false, [](EdgeSink &sink, int n) { randomRegularGraph(sink, n, 3); } },
+		{ "randomGeographicalThresholdGraph", true, [](EdgeSink &sink, int n) { randomGeographicalThresholdGraph(sink, n, 2.0, n / 10.0); } },
+		{ "randomGeographicalThresholdWeightsGraph", true, [](EdgeSink &sink, int n) { randomGeographicalThresholdWeightsGraph(sink, constantWeights(n, 1), 2.0, n / 5.0); } },
+		{ "randomGeometricCubeGraph", true, [=](EdgeSink &sink, int n) { randomGeometricCubeGraph(sink, n, geometricThreshold(n)); } },
+		{ "randomGeometricTorusGraph", true, [=](EdgeSink &sink, int n) { randomGeometricTorusGraph(sink, n, geometricThreshold(n)); } },
+		{ "randomRMatGraph", false, [](EdgeSink &sink, int n) { randomRMatGraph(sink, std::max(ilogb(n), 0), 8); } },
+		{ "randomRMatGraphNoisy", false, [](EdgeSink &sink, int n) { randomRMatGraph(sink, std::max(ilogb(n), 0), 8, 0.57, 0.19, 0.19, 0.1); } },
+		{ "randomHyperbolicGraph", true, [](EdgeSink &sink, int n) { randomHyperbolicGraph(sink, n, 10, 2.5); } },
+		{ "randomHyperbolicGraphFast", false, [](EdgeSink &sink, int n) { randomHyperbolicGraphFast(sink, n, 10, 2.5); } },
+		{ "randomHyperbolicGraphFastTemperature", false, [](EdgeSink &sink, int n) { randomHyperbolicGraphFast(sink, n, 10, 2.5, 0.5); } },
+		{ "randomWaxmanGraphUsingPlane", true, [=](EdgeSink &sink, int n) { randomWaxmanGraphUsingPlane(sink, n, planeAlpha(n), 0.1); } },
+		{ "randomWaxmanGraphUsingPlaneFast", false, [=](EdgeSink &sink, int n) { randomWaxmanGraphUsingPlaneFast(sink, n, planeAlpha(n), 0.1); } },
+		{ "randomWaxmanGraphUsingPlaneFastHilbert", false, [=](EdgeSink &sink, int n) { randomWaxmanGraphUsingPlaneFast(sink, n, planeAlpha(n), 0.1, NodeOrder::Hilbert); } },
+		{ "randomWaxmanGraphUsingGrid", true, [=](EdgeSink &sink, int n) { randomWaxmanGraphUsingGrid(sink, n, planeAlpha(n), 0.1, 100, 100); } },
+		{ "randomWaxmanGraphUsingGridFast", false, [=](EdgeSink &sink, int n) { randomWaxmanGraphUsingGridFast(sink, n, planeAlpha(n), 0.1, 100, 100); } },
+		{ "randomWaxmanGraph", true, [=](EdgeSink &sink, int n) { randomWaxmanGraph(sink, n, modelTwoAlpha(n), 0.1); } },
+		{ "randomWaxmanGraphFast", false, [=](EdgeSink &sink, int n) { randomWaxmanGraphFast(sink, n, modelTwoAlpha(n), 0.1); } },
+		{ "randomWaxmanGraphIntegral", true, [=](EdgeSink &sink, int n) { randomWaxmanGraphIntegral(sink, n, modelTwoAlpha(n), 0.1, 1000); } },
+		{ "randomWaxmanGraphIntegralFast", false, [=](EdgeSink &sink, int n) { randomWaxmanGraphIntegralFast(sink, n, modelTwoAlpha(n), 0.1, 1000); } },
+	};
+}
+
+struct Options {
+	int minExponent = 3;
+	int maxExponent = 7;
+	std::vector<std::string> generators;
+	std::string sink = "count";
+	int seed = 1;
+	int timeout = 60;
+	double maxPairs = 2e9;
+	std::string output;
+};
+
+//! Result of a single run as reported by the child process.
+struct Result {
+	long long nodes = 0;
+	long long edges = 0;
+	double seconds = 0;
+	long long peakRss = 0;
+	GeneratorStats stats;
+};
+
+//! Runs \p generator in the calling process and returns its result.
+Result measure(const Generator &generator, int n, const Options &options) {
+	setSeed(options.seed);
+	generatorStats().reset();
+
+	Result result;
+	auto start = std::chrono::steady_clock::now();
+	if (options.sink == "graph") {
+		Graph G;
+		GraphSink sink(G);
+		generator.run(sink, n);
+		result.nodes = G.numberOfNodes();
+		result.edges = G.numberOfEdges();
+	} else if (options.sink == "csr") {
+		CsrSink sink;
+		generator.run(sink, n);
+		result.nodes = sink.numberOfNodes();
+		result.edges = (long long)sink.numberOfEdges();
+	} else if (options.sink == "statistics") {
+		StatisticsSink sink;
+		generator.run(sink, n);
+		result.nodes = sink.numberOfNodes();
+		result.edges = sink.numberOfEdges();
+	} else if (options.sink == "compressed") {
+		CompressedGraphSink sink;
+		generator.run(sink, n);
+		result.nodes = sink.numberOfNodes();
+		result.edges = (long long)sink.numberOfEdges();
+	} else {
+		CountingSink sink;
+		generator.run(sink, n);
+		result.nodes = sink.numberOfNodes();
+		result.edges = sink.numberOfEdges();
+	}
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	result.stats = generatorStats();
+
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	result.peakRss = (long long)usage.ru_maxrss * 1024;
+	return result;
+}
+
+//! Runs \p generator in a child process; returns false if it failed or timed out.
+bool measureInChild(const Generator &generator, int n, const Options &options, Result &result, std::string &error) {
+	int channel[2];
+	if (pipe(channel) != 0) {
+		error = "pipe";
+		return false;
+	}
+
+	pid_t child = fork();
+	if (child == 0) {
+		close(channel[0]);
+		alarm((unsigned)options.timeout);
+		Result measured = measure(generator, n, options);
+		ssize_t written = write(channel[1], &measured, sizeof(measured));
+		_exit(written == (ssize_t)sizeof(measured) ? 0 : 1);
+	}
+
+	close(channel[1]);
+	ssize_t received = read(channel[0], &result, sizeof(result));
+	close(channel[0]);
+
+	int status = 0;
+	waitpid(child, &status, 0);
+	if (WIFSIGNALED(status)) {
+		error = WTERMSIG(status) == SIGALRM ? "timeout" : "signal " + std::to_string(WTERMSIG(status));
+		return false;
+	}
+	if (received != (ssize_t)sizeof(result) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		error = "failed";
+		return false;
+	}
+	return true;
+}
+
+bool parse(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; i++) {
+		std::string flag = argv[i];
+		if (i + 1 == argc) {
+			return false;
+		}
+		std::string value = argv[++i];
+		if (flag == "--min-exponent") {
+			options.minExponent = std::atoi(value.c_str());
+		} else if (flag == "--max-exponent") {
+			options.maxExponent = std::atoi(value.c_str());
+		} else if (flag == "--generators") {
+			std::stringstream names(value);
+			for (std::string name; std::getline(names, name, ',');) {
+				options.generators.push_back(name);
+			}
+		} else if (flag == "--sink") {
+			options.sink = value;
+		} else if (flag == "--seed") {
+			options.seed = std::atoi(value.c_str());
+		} else if (flag == "--timeout") {
+			options.timeout = std::atoi(value.c_str());
+		} else if (flag == "--max-pairs") {
+			options.maxPairs = std::atof(value.c_str());
+		} else if (flag == "--output") {
+			options.output = value;
+		} else {
+			return false;
+		}
+	}
+	return options.sink == "count" || options.sink == "csr" || options.sink == "compressed" || options.sink == "graph"
+		|| options.sink == "statistics";
+}
+
+bool selected(const Options &options, const char *name) {
+	if (options.generators.empty()) {
+		return true;
+	}
+	for (const std::string &s : options.generators) {
+		if (s == name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parse(argc, argv, options)) {
+		fprintf(stderr, "usage: %s [--min-exponent e] [--max-exponent e] [--generators a,b,...]"
+			" [--sink count|csr|compressed|graph|statistics] [--seed s] [--timeout seconds] [--max-pairs p] [--output file]\n", argv[0]);
+		return 2;
+	}
+
+	FILE *out = options.output.empty() ? stdout : fopen(options.output.c_str(), "w");
+	if (out == nullptr) {
+		perror(options.output.c_str());
+		return 1;
+	}
+
+	fprintf(out, "{\n  \"sink\": \"%s\",\n  \"seed\": %d,\n  \"results\": [", options.sink.c_str(), options.seed);
+	bool first = true;
+	for (const Generator &generator : generators()) {
+		if (!selected(options, generator.name)) {
+			continue;
+		}
+
+		for (int exponent = options.minExponent; exponent <= options.maxExponent; exponent++) {
+			int n = (int)std::lround(std::pow(10.0, exponent));
+			fprintf(out, "%s\n    { \"generator\": \"%s\", \"n\": %d", first ? "" : ",", generator.name, n);
+			first = false;
+
+			Result result;
+			std::string error;
+			if (generator.quadratic && 0.5 * n * (n - 1.0) > options.maxPairs) {
+				fprintf(out, ", \"skipped\": \"quadratic\" }");
+			} else if (!measureInChild(generator, n, options, result, error)) {
+				fprintf(out, ", \"skipped\": \"%s\" }", error.c_str());
+			} else {
+				const GeneratorStats &stats = result.stats;
+				fprintf(out, ", \"nodes\": %lld, \"edges\": %lld, \"seconds\": %.6f"
+					", \"nodesPerSecond\": %.1f, \"edgesPerSecond\": %.1f"
+					", \"peakRssBytes\": %lld, \"rngDraws\": %llu, \"rngDrawsPerEdge\": %.3f"
+					", \"setupSeconds\": %.6f, \"edgesSeconds\": %.6f, \"finishSeconds\": %.6f"
+					", \"rejections\": %llu, \"restarts\": %llu, \"pairsExamined\": %llu, \"edgesEmitted\": %llu }",
+					result.nodes, result.edges, result.seconds,
+					result.nodes / result.seconds, result.edges / result.seconds,
+					result.peakRss, (unsigned long long)stats.randomDraws,
+					result.edges > 0 ? (double)stats.randomDraws / result.edges : 0.0,
+					stats.time(GeneratorStats::Phase::Setup), stats.time(GeneratorStats::Phase::Edges),
+					stats.time(GeneratorStats::Phase::Finish),
+					(unsigned long long)stats.rejections, (unsigned long long)stats.restarts,
+					(unsigned long long)stats.pairsExamined, (unsigned long long)stats.edgesEmitted);
+			}
+			fflush(out);
+		}
+	}
+	fprintf(out, "\n  ]\n}\n");
+
+	if (out != stdout) {
+		fclose(out);
+	}
+	return 0;
+}
@@ -9,44 +9,64 @@
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <string>
+#include <vector>
 
 #include <ogdf/basic/Graph.h> 
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/basic/graph_generators.h>
 
-using std::minstd_rand;
+#include "../common/Checkpoint.h"
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Random.h"
+#include "../common/ScratchArena.h"
+
 using std::uniform_int_distribution;
 using std::uniform_real_distribution;
 using namespace ogdf;
 
-//! Creates a Bipartite Preferential Attachment Graph. 
+//! Creates a Bipartite Preferential Attachment Graph, saving to \p checkpoint if it is not nullptr.
 /**
- * @param G is assigned the generated graph.
- * @param n is the number of nodes in each of sets.
- * @param d is the minimum degree.
+ * Node v only writes the entries of M1 and M2 at indices 2 v d + 1 and
+ * above, so the prefixes completed by the nodes before it, together with v
+ * and the state of the random number engine, are the state of the run.
  */
-void randomBipartitePrefrentialGraph(Graph &G, int n, int d) {
+static void generateBipartite(EdgeSink &sink, int n, int d, Checkpoint *checkpoint) {
 	OGDF_ASSERT(1 <= d && d <= n);
-	G.clear();
 
-	Array<int> M1(2*n*d), M2(2*n*d);
-	Array<node> v(2*n*d);
+	GeneratorProbe probe;
+	RandomEngine rng(generatorSeed());
+	ScratchFrame scratch;
+	int *M1 = scratch.allocate<int>(2*n*d, 0);
+	int *M2 = scratch.allocate<int>(2*n*d, 0);
+	sink.reserve(2*n*d, 2*n*d);
 	for (int i = 0; i < 2 * n*d; i++) {
-		v[i] = G.newNode();
+		sink.addNode();
 	}
 
-	for (int i = 0; i < M1.size(); i++) {
-		M1[i] = 0;
-		M2[i] = 0;
+	int start = 0;
+	if (checkpoint != nullptr) {
+		std::vector<int> prefix1, prefix2;
+		// the next node followed by the state of the random number engine
+		std::vector<uint64_t> scalars(1 + RandomEngine::stateSize, 0);
+		std::string parameters = "n=" + std::to_string(n) + " d=" + std::to_string(d);
+		if (checkpoint->resume("randomBipartitePrefrentialGraph", parameters, {&prefix1, &prefix2}, scalars)) {
+			start = (int)scalars[0];
+			OGDF_ASSERT(start <= n && prefix1.size() <= (size_t)2*n*d && prefix2.size() <= (size_t)2*n*d);
+			std::copy(prefix1.begin(), prefix1.end(), M1);
+			std::copy(prefix2.begin(), prefix2.end(), M2);
+			rng.setState(&scalars[1]);
+		}
 	}
 
-	for (int v = 0; v < n; v++) {
+	probe.phase(GeneratorStats::Phase::Edges);
+	for (int v = start; v < n; v++) {
 		for (int i = 0; i < d; i++) {
 			M1[2 * (v*d + 1)] = v;
 			M2[2 * (v*d + 1)] = n + v;
 
-			minstd_rand rng(randomSeed());
 			int x = 2 * (v*d + i) - 1;
 			
 			//! v = 0, i = 0 leads to x = -1 
@@ -68,19 +88,74 @@ void randomBipartitePrefrentialGraph(Graph &G, int n, int d) {
 			else
 				M2[2 * (v*d + i) + 1] = M2[r];
 		}
+
+		if (checkpoint != nullptr && checkpoint->due()) {
+			// the entry at 2 (v + 1) d is written by node v if d = 1
+			size_t length = std::min<size_t>(2 * (size_t)(v + 1) * d + 1, 2 * (size_t)n * d);
+			checkpoint->save({{M1, length}, {M2, length}}, {(uint64_t)v + 1, rng.state(0), rng.state(1), rng.state(2), rng.state(3)});
+		}
 	}
 
+	probe.pairs(2 * (uint64_t)n * d);
 	for (int i = 0; i < n*d; i++) {
 		if (M1[2 * i] != M1[2 * i + 1]) {
-			G.newEdge(v[M1[2 * i]], v[M1[2 * i + 1]]);
+			sink.addEdge(M1[2 * i], M1[2 * i + 1]);
+			probe.edges();
+		} else {
+			probe.rejections();
 		}
 
 		if (M2[2 * i] != M2[2 * i + 1]) {
-			G.newEdge(v[M2[2 * i]], v[M2[2 * i + 1]]);
+			sink.addEdge(M2[2 * i], M2[2 * i + 1]);
+			probe.edges();
+		} else {
+			probe.rejections();
 		}
 	}
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Bipartite Preferential Attachment Graph. 
+/**
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes in each of sets.
+ * @param d is the minimum degree.
+ */
+void randomBipartitePrefrentialGraph(EdgeSink &sink, int n, int d) {
+	generateBipartite(sink, n, d, nullptr);
+}
+
+//! Creates a Bipartite Preferential Attachment Graph, resuming from and saving to \p checkpoint.
+/**
+ * If \p checkpoint holds a checkpoint of a run with the same \p n and
+ * \p d, the graph written to \p sink equals the one of that run, whatever
+ * seed is active now.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes in each of sets.
+ * @param d is the minimum degree.
+ * @param checkpoint is the checkpoint file to resume from and save to.
+ * \throws CheckpointMismatch if the file of \p checkpoint holds anything but a checkpoint of this run.
+ */
+void randomBipartitePrefrentialGraph(EdgeSink &sink, int n, int d, Checkpoint &checkpoint) {
+	generateBipartite(sink, n, d, &checkpoint);
+}
+
+//! Creates a Bipartite Preferential Attachment Graph. 
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes in each of sets.
+ * @param d is the minimum degree.
+ */
+void randomBipartitePrefrentialGraph(Graph &G, int n, int d) {
+	G.clear();
+	GraphSink sink(G);
+	randomBipartitePrefrentialGraph(sink, n, d);
 }
 
+#ifndef OGDF_GENERATORS_LIBRARY
 int main(){
 	//! TODO: tests
 	Graph G;
@@ -91,3 +166,4 @@ int main(){
 	std::cout << G.numberOfEdges() << endl;
 	return 0;
 }
+#endif
@@ -0,0 +1,141 @@
+/** \file
+ * \brief Declaration of BatchRandom, which draws uniform doubles in blocks.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "GeneratorStats.h"
+#include "Random.h"
+
+namespace ogdf {
+
+//! Four interleaved xoshiro256++ generators that fill blocks of uniform doubles in [0, 1).
+/**
+ * Drawing one double from RandomEngine through
+ * std::uniform_real_distribution costs a call per number that the compiler
+ * cannot vectorize. Here, the four generators advance in lockstep, which maps onto
+ * one AVX2 register per state word if the code is compiled with AVX2 and
+ * is easy to vectorize otherwise; the portable code produces the same
+ * numbers. A double is formed from the upper 52 bits of an output by
+ * setting the exponent of [1, 2) and subtracting 1, so all 2^52 values
+ * k * 2^-52 are equally likely.
+ *
+ * The pair loops of the generators call next() once per decision, so a
+ * block is refilled every blockSize draws.
+ */
+class BatchRandom {
+public:
+	//! Number of doubles produced per refill.
+	static constexpr int blockSize = 256;
+
+private:
+	static constexpr int s_lanes = 4;
+
+	//! m_state[i][l] is the i-th state word of lane l.
+	alignas(32) uint64_t m_state[4][s_lanes];
+	alignas(64) double m_block[blockSize];
+	int m_next = blockSize;
+
+	static uint64_t rotl(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+	void refill() {
+#ifdef __AVX2__
+		__m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i *>(m_state[0]));
+		__m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i *>(m_state[1]));
+		__m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i *>(m_state[2]));
+		__m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i *>(m_state[3]));
+		const __m256i exponent = _mm256_set1_epi64x(0x3ff0000000000000LL);
+		const __m256d one = _mm256_set1_pd(1.0);
+
+		for (int i = 0; i < blockSize; i += s_lanes) {
+			__m256i sum = _mm256_add_epi64(s0, s3);
+			__m256i result = _mm256_add_epi64(
+				_mm256_or_si256(_mm256_slli_epi64(sum, 23), _mm256_srli_epi64(sum, 41)), s0);
+
+			__m256i t = _mm256_slli_epi64(s1, 17);
+			s2 = _mm256_xor_si256(s2, s0);
+			s3 = _mm256_xor_si256(s3, s1);
+			s1 = _mm256_xor_si256(s1, s2);
+			s0 = _mm256_xor_si256(s0, s3);
+			s2 = _mm256_xor_si256(s2, t);
+			s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+
+			__m256i bits = _mm256_or_si256(_mm256_srli_epi64(result, 12), exponent);
+			_mm256_store_pd(m_block + i, _mm256_sub_pd(_mm256_castsi256_pd(bits), one));
+		}
+
+		_mm256_store_si256(reinterpret_cast<__m256i *>(m_state[0]), s0);
+		_mm256_store_si256(reinterpret_cast<__m256i *>(m_state[1]), s1);
+		_mm256_store_si256(reinterpret_cast<__m256i *>(m_state[2]), s2);
+		_mm256_store_si256(reinterpret_cast<__m256i *>(m_state[3]), s3);
+#else
+		uint64_t (&s)[4][s_lanes] = m_state;
+		for (int i = 0; i < blockSize; i += s_lanes) {
+			for (int l = 0; l < s_lanes; l++) {
+				uint64_t result = rotl(s[0][l] + s[3][l], 23) + s[0][l];
+
+				uint64_t t = s[1][l] << 17;
+				s[2][l] ^= s[0][l];
+				s[3][l] ^= s[1][l];
+				s[1][l] ^= s[2][l];
+				s[0][l] ^= s[3][l];
+				s[2][l] ^= t;
+				s[3][l] = rotl(s[3][l], 45);
+
+				uint64_t bits = (result >> 12) | 0x3ff0000000000000ULL;
+				double value;
+				std::memcpy(&value, &bits, sizeof(value));
+				m_block[i + l] = value - 1.0;
+			}
+		}
+#endif
+
+#ifdef OGDF_GENERATORS_STATS
+		generatorStats().randomDraws += blockSize;
+#endif
+		m_next = 0;
+	}
+
+public:
+	//! Seeds the lanes with consecutive SplitMix64 outputs of \p seed.
+	explicit BatchRandom(uint64_t seed) {
+		for (int l = 0; l < s_lanes; l++) {
+			for (int i = 0; i < 4; i++) {
+				m_state[i][l] = splitMix64(seed + (uint64_t)(4 * l + i) * 0x9e3779b97f4a7c15ULL);
+			}
+		}
+	}
+
+	//! Seeds the lanes from block \p block of stream \p stream, see CounterStream.
+	/**
+	 * Pair loops use one block per node, so that the decisions for the
+	 * pairs of any node can be regenerated without the others.
+	 */
+	BatchRandom(uint64_t seed, uint64_t stream, uint64_t block) {
+		CounterStream counter(seed, stream, block);
+		for (int l = 0; l < s_lanes; l++) {
+			for (int i = 0; i < 4; i++) {
+				m_state[i][l] = counter();
+			}
+		}
+	}
+
+	//! Returns the next uniform double in [0, 1).
+	double next() {
+		if (m_next == blockSize) {
+			refill();
+		}
+		return m_block[m_next++];
+	}
+};
+
+}
@@ -0,0 +1,391 @@
+/** \file
+ * \brief Declaration of Checkpoint, which lets long-running sequential
+ * generators resume after they were interrupted.
+ *
+ * A checkpoint file consists of a header of CheckpointHeader::size bytes,
+ * naming the generator and its parameters, followed by records. The state
+ * of a generator is a few integer arrays that only grow at their end, e.g.
+ * the endpoints of the edges generated so far, and a few scalars, e.g. the
+ * index of the next node and the state of the random number engine. Every
+ * record holds the entries appended to the arrays since the previous record,
+ * the current scalars and a checksum, so writing a checkpoint costs time
+ * linear in what was generated since the last one. Records are written by a
+ * background thread while the generator continues; a record torn by a crash
+ * is detected by its checksum and ignored when resuming.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ogdf/basic/basic.h>
+
+namespace ogdf {
+
+//! Header of a checkpoint file.
+struct CheckpointHeader {
+	static constexpr size_t size = 512;
+
+	//! Identifies the file format.
+	static const char *magic() { return "OGDFCKPT"; }
+
+	static constexpr uint32_t currentVersion = 1;
+
+	//! Written as is, to detect files from machines with a different byte order.
+	static constexpr uint32_t byteOrderMark = 0x01020304;
+
+	char magicBytes[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint32_t numberOfArrays;
+	uint32_t numberOfScalars;
+	char model[64];
+	char parameters[size - 88];
+};
+
+static_assert(sizeof(CheckpointHeader) == CheckpointHeader::size, "unexpected padding in CheckpointHeader");
+
+//! Thrown by Checkpoint::resume() if the file is not a checkpoint of the same generator and parameters.
+class CheckpointMismatch : public std::runtime_error {
+public:
+	explicit CheckpointMismatch(const std::string &path)
+		: std::runtime_error(path + " is not a checkpoint of this run") { }
+};
+
+
+//! Periodic, asynchronously written checkpoints of a sequential generator.
+/**
+ * A generator that supports checkpoints first calls resume(), which either
+ * restores its arrays and scalars from the last complete record of the file
+ * or starts a new file if there is none; the file of another run is never
+ * overwritten, resume() throws CheckpointMismatch instead. It then calls save() whenever due() says so, at
+ * points where its arrays and scalars determine the rest of the run. The
+ * generators replay what the restored state already contains into their
+ * sink, so a resumed run produces exactly the output of an uninterrupted
+ * one, independent of the seed it was started with.
+ *
+ * save() hands the new entries to the background writer and returns at
+ * once; if the writer is still busy with the previous record, the
+ * checkpoint is skipped and the next one covers both. Only with an
+ * interval of 0, which saves at every opportunity and is meant for tests,
+ * save() waits for the writer instead.
+ *
+ * \code
+ * Checkpoint checkpoint("graph.checkpoint", 300);
+ * preferentialAttachmentGraph(sink, n, d, checkpoint);   // resumes if the file holds a checkpoint of this run
+ * \endcode
+ */
+class Checkpoint {
+	std::string m_path;
+	std::chrono::steady_clock::duration m_interval;
+	std::chrono::steady_clock::time_point m_next;
+	int m_countdown;
+	int m_fd;
+	std::vector<size_t> m_saved;
+	std::atomic<bool> m_failed;
+	std::atomic<long long> m_records;
+
+	std::thread m_writer;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_idle;
+	std::vector<char> m_pending;
+	bool m_busy;
+	bool m_stop;
+
+	//! Number of calls of due() between two looks at the clock.
+	static constexpr int s_clockPeriod = 256;
+
+	//! Returns the FNV-1a hash of \p length bytes at \p data.
+	static uint64_t checksum(const char *data, size_t length) {
+		uint64_t hash = 0xcbf29ce484222325ULL;
+		for (size_t i = 0; i < length; i++) {
+			hash = (hash ^ (unsigned char)data[i]) * 0x100000001b3ULL;
+		}
+		return hash;
+	}
+
+	void write() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (;;) {
+			m_wake.wait(lock, [&] { return m_stop || m_busy; });
+			if (!m_busy) return;
+
+			// the record is complete once its checksum is written
+			std::vector<char> record;
+			record.swap(m_pending);
+			lock.unlock();
+			uint64_t sum = checksum(record.data(), record.size());
+			record.insert(record.end(), reinterpret_cast<const char *>(&sum), reinterpret_cast<const char *>(&sum) + sizeof(sum));
+			bool written = writeAll(record.data(), record.size()) && ::fdatasync(m_fd) == 0;
+			lock.lock();
+
+			if (written) {
+				m_records++;
+			} else {
+				m_failed = true;
+			}
+			m_busy = false;
+			m_idle.notify_all();
+		}
+	}
+
+	bool writeAll(const char *data, size_t length) {
+		while (length > 0) {
+			ssize_t written = ::write(m_fd, data, length);
+			if (written <= 0) return false;
+			data += written;
+			length -= (size_t)written;
+		}
+		return true;
+	}
+
+	//! Appends the \p count bytes at \p data to \p record.
+	static void append(std::vector<char> &record, const void *data, size_t count) {
+		const char *bytes = static_cast<const char *>(data);
+		record.insert(record.end(), bytes, bytes + count);
+	}
+
+	//! Returns the end of the record at \p position of the \p length bytes at \p file, or 0 if it is incomplete or damaged.
+	/**
+	 * The numbers of entries the record appends to each of the \p numberOfArrays
+	 * arrays are added to \p counts if it is complete.
+	 */
+	static size_t recordEnd(const char *file, size_t length, size_t position, size_t numberOfArrays, size_t numberOfScalars,
+			std::vector<uint64_t> &counts) {
+		size_t start = position;
+		std::vector<uint64_t> record(numberOfArrays);
+		for (uint64_t &count : record) {
+			if (position + sizeof(count) > length) return 0;
+			memcpy(&count, file + position, sizeof(count));
+			position += sizeof(count);
+			if (count > (length - position) / sizeof(int)) return 0;
+			position += (size_t)count * sizeof(int);
+		}
+		uint64_t sum;
+		if (position + (numberOfScalars + 1) * sizeof(uint64_t) > length) return 0;
+		position += numberOfScalars * sizeof(uint64_t);
+		memcpy(&sum, file + position, sizeof(sum));
+		if (sum != checksum(file + start, position - start)) return 0;
+
+		for (size_t a = 0; a < numberOfArrays; a++) {
+			counts[a] += record[a];
+		}
+		return position + sizeof(sum);
+	}
+
+public:
+	//! Creates checkpoints in the file \p path, at most one per \p interval seconds.
+	explicit Checkpoint(const std::string &path, double interval = 60.0)
+		: m_path(path),
+		  m_interval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(interval))),
+		  m_countdown(0), m_fd(-1), m_failed(false), m_records(0), m_busy(false), m_stop(false) { }
+
+	Checkpoint(const Checkpoint &) = delete;
+	Checkpoint &operator=(const Checkpoint &) = delete;
+
+	//! Writes the pending record and closes the file.
+	~Checkpoint() {
+		if (m_writer.joinable()) {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_wake.notify_all();
+			m_writer.join();
+		}
+		if (m_fd >= 0) {
+			::close(m_fd);
+		}
+	}
+
+	//! Restores the state of the generator \p model with \p parameters; returns false if there is none.
+	/**
+	 * If the file holds checkpoints of the same model and parameters, the
+	 * entries of all its complete records are appended to \p arrays and the
+	 * scalars of the last one are assigned to \p scalars; a torn last record
+	 * is cut off. The file is mapped rather than read, and the arrays are
+	 * grown once to their final sizes, so restoring takes no memory beyond
+	 * them. If the file does not exist or is empty, a new checkpoint file is
+	 * started and \p arrays and \p scalars are left unchanged.
+	 *
+	 * \throws CheckpointMismatch if the file holds anything else, e.g. the
+	 * checkpoints of other parameters, or cannot be read; it is left
+	 * untouched.
+	 */
+	bool resume(const std::string &model, const std::string &parameters,
+			std::initializer_list<std::vector<int> *> arrays, std::vector<uint64_t> &scalars) {
+		OGDF_ASSERT(m_fd < 0);
+
+		CheckpointHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magicBytes, CheckpointHeader::magic(), sizeof(header.magicBytes));
+		header.version = CheckpointHeader::currentVersion;
+		header.byteOrder = CheckpointHeader::byteOrderMark;
+		header.numberOfArrays = (uint32_t)arrays.size();
+		header.numberOfScalars = (uint32_t)scalars.size();
+		strncpy(header.model, model.c_str(), sizeof(header.model) - 1);
+		strncpy(header.parameters, parameters.c_str(), sizeof(header.parameters) - 1);
+
+		size_t length = 0;
+		void *mapping = MAP_FAILED;
+		int fd = ::open(m_path.c_str(), O_RDONLY);
+		if (fd < 0 && errno != ENOENT) {
+			throw CheckpointMismatch(m_path);
+		}
+		if (fd >= 0) {
+			struct stat info;
+			if (fstat(fd, &info) != 0) {
+				::close(fd);
+				throw CheckpointMismatch(m_path);
+			}
+			length = (size_t)info.st_size;
+			if (length > 0) {
+				mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+			}
+			::close(fd);
+		}
+		const char *file = static_cast<const char *>(mapping);
+
+		if (length > 0 && (mapping == MAP_FAILED || length < CheckpointHeader::size
+		 || memcmp(file, &header, CheckpointHeader::size) != 0)) {
+			if (mapping != MAP_FAILED) {
+				munmap(mapping, length);
+			}
+			throw CheckpointMismatch(m_path);
+		}
+
+		bool resumed = false;
+		size_t valid = 0;
+		if (length > 0) {
+			valid = CheckpointHeader::size;
+			madvise(mapping, length, MADV_SEQUENTIAL);
+
+			// finding the complete records and the numbers of their entries
+			std::vector<uint64_t> counts(arrays.size(), 0);
+			for (size_t end; (end = recordEnd(file, length, valid, arrays.size(), scalars.size(), counts)) > 0;) {
+				valid = end;
+			}
+
+			// copying them straight from the mapping into the arrays
+			if (valid > CheckpointHeader::size) {
+				auto array = arrays.begin();
+				for (uint64_t count : counts) {
+					(*array)->reserve((*array)->size() + (size_t)count);
+					++array;
+				}
+				size_t position = CheckpointHeader::size;
+				while (position < valid) {
+					for (std::vector<int> *target : arrays) {
+						uint64_t count;
+						memcpy(&count, file + position, sizeof(count));
+						position += sizeof(count);
+						const int *entries = reinterpret_cast<const int *>(file + position);
+						target->insert(target->end(), entries, entries + count);
+						position += (size_t)count * sizeof(int);
+					}
+					// the scalars of the last record
+					if (position + (scalars.size() + 1) * sizeof(uint64_t) == valid) {
+						memcpy(scalars.data(), file + position, scalars.size() * sizeof(uint64_t));
+					}
+					position += (scalars.size() + 1) * sizeof(uint64_t);
+				}
+				resumed = true;
+			}
+			munmap(mapping, length);
+		}
+
+		if (valid > 0) {
+			m_fd = ::open(m_path.c_str(), O_WRONLY);
+			if (m_fd < 0 || ::ftruncate(m_fd, (off_t)valid) != 0 || ::lseek(m_fd, (off_t)valid, SEEK_SET) < 0) {
+				m_failed = true;
+			}
+		} else {
+			// only a missing or empty file is replaced
+			m_fd = ::open(m_path.c_str(), O_WRONLY | O_CREAT, 0644);
+			if (m_fd < 0 || !writeAll(reinterpret_cast<const char *>(&header), sizeof(header)) || ::fsync(m_fd) != 0) {
+				m_failed = true;
+			}
+		}
+
+		for (std::vector<int> *array : arrays) {
+			m_saved.push_back(array->size());
+		}
+		m_next = std::chrono::steady_clock::now() + m_interval;
+		if (!m_failed) {
+			m_writer = std::thread([this] { write(); });
+		}
+		return resumed;
+	}
+
+	//! Returns true if the interval has passed since the last checkpoint.
+	bool due() {
+		if (m_failed) return false;
+		if (m_interval.count() > 0 && --m_countdown > 0) return false;
+		m_countdown = s_clockPeriod;
+		return std::chrono::steady_clock::now() >= m_next;
+	}
+
+	//! Queues a checkpoint of the \p arrays, given by their data and length, and the \p scalars; returns false if it is skipped.
+	/**
+	 * The arrays must be the ones passed to resume(), grown at their ends;
+	 * only their new entries are copied.
+	 */
+	bool save(std::initializer_list<std::pair<const int *, size_t>> arrays, std::initializer_list<uint64_t> scalars) {
+		OGDF_ASSERT(arrays.size() == m_saved.size());
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_interval.count() <= 0) {
+			m_idle.wait(lock, [&] { return !m_busy; });
+		}
+		if (m_busy || m_failed || !m_writer.joinable()) return false;
+
+		m_pending.clear();
+		size_t a = 0;
+		for (const auto &array : arrays) {
+			uint64_t count = array.second - m_saved[a];
+			append(m_pending, &count, sizeof(count));
+			append(m_pending, array.first + m_saved[a], (size_t)count * sizeof(int));
+			m_saved[a++] = array.second;
+		}
+		for (uint64_t value : scalars) {
+			append(m_pending, &value, sizeof(value));
+		}
+		m_busy = true;
+		lock.unlock();
+		m_wake.notify_one();
+
+		m_next = std::chrono::steady_clock::now() + m_interval;
+		return true;
+	}
+
+	//! Waits until the queued checkpoint is written.
+	void wait() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_idle.wait(lock, [&] { return !m_busy; });
+	}
+
+	//! Returns false if the file could not be created or written.
+	bool good() const { return !m_failed; }
+
+	//! Returns the number of records written by this object.
+	long long records() const { return m_records; }
+};
+
+}
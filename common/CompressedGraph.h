@@ -0,0 +1,484 @@
+/** \file
+ * \brief Declaration of CompressedGraphSink, a bit-packed adjacency structure in the style of WebGraph.
+ *
+ * Each undirected edge {u, v}, u <= v, is stored in the sorted successor
+ * list of u and in the sorted predecessor list of v. A list is encoded as
+ * the gaps between consecutive neighbors (the first one relative to the node)
+ * in a Rice code whose parameter is chosen per list, so sparse graphs take
+ * about log2(average gap) + 2 bits per edge and list.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "EdgeSink.h"
+
+namespace ogdf {
+
+namespace compressed_graph {
+
+//! Appends codes bitwise, least significant bit first, to a vector of words.
+class BitWriter {
+	std::vector<uint64_t> &m_words;
+	uint64_t m_bits;
+
+public:
+	explicit BitWriter(std::vector<uint64_t> &words) : m_words(words), m_bits(0) {
+		m_words.clear();
+	}
+
+	//! Returns the number of bits written so far.
+	uint64_t position() const { return m_bits; }
+
+	//! Writes the lowest \p count bits of \p value, \p count <= 64.
+	void write(uint64_t value, int count) {
+		if (count == 0) return;
+		if (count < 64) value &= (uint64_t(1) << count) - 1;
+
+		size_t word = (size_t)(m_bits >> 6);
+		int offset = (int)(m_bits & 63);
+		while (m_words.size() < word + 2) {
+			m_words.push_back(0);
+		}
+		m_words[word] |= value << offset;
+		if (offset + count > 64) {
+			m_words[word + 1] |= value >> (64 - offset);
+		}
+		m_bits += (uint64_t)count;
+	}
+
+	//! Writes \p value zeros followed by a one.
+	void writeUnary(uint64_t value) {
+		for (; value >= 64; value -= 64) {
+			write(0, 64);
+		}
+		write(uint64_t(1) << value, (int)value + 1);
+	}
+
+	//! Writes \p value >= 1 in Elias gamma code.
+	void writeGamma(uint64_t value) {
+		int length = 63 - __builtin_clzll(value);
+		writeUnary((uint64_t)length);
+		write(value, length);
+	}
+
+	//! Writes \p value in Rice code with parameter \p k.
+	void writeRice(uint64_t value, int k) {
+		writeUnary(value >> k);
+		write(value, k);
+	}
+
+	//! Releases unused capacity; afterwards the words can be read with a BitReader.
+	void close() {
+		m_words.resize((size_t)(m_bits >> 6) + 2, 0);
+		m_words.shrink_to_fit();
+	}
+};
+
+//! Reads codes written by a BitWriter.
+class BitReader {
+	const uint64_t *m_words;
+	uint64_t m_bits;
+
+public:
+	BitReader(const uint64_t *words, uint64_t position) : m_words(words), m_bits(position) { }
+
+	//! Returns the number of bits read so far.
+	uint64_t position() const { return m_bits; }
+
+	uint64_t read(int count) {
+		if (count == 0) return 0;
+		size_t word = (size_t)(m_bits >> 6);
+		int offset = (int)(m_bits & 63);
+		uint64_t value = m_words[word] >> offset;
+		if (offset + count > 64) {
+			value |= m_words[word + 1] << (64 - offset);
+		}
+		m_bits += (uint64_t)count;
+		return count < 64 ? value & ((uint64_t(1) << count) - 1) : value;
+	}
+
+	uint64_t readUnary() {
+		uint64_t value = 0;
+		for (;;) {
+			size_t word = (size_t)(m_bits >> 6);
+			int offset = (int)(m_bits & 63);
+			uint64_t rest = m_words[word] >> offset;
+			if (rest != 0) {
+				int zeros = __builtin_ctzll(rest);
+				m_bits += (uint64_t)zeros + 1;
+				return value + (uint64_t)zeros;
+			}
+			value += (uint64_t)(64 - offset);
+			m_bits += (uint64_t)(64 - offset);
+		}
+	}
+
+	uint64_t readGamma() {
+		int length = (int)readUnary();
+		return (uint64_t(1) << length) | read(length);
+	}
+
+	uint64_t readRice(int k) {
+		uint64_t high = readUnary();
+		return (high << k) | read(k);
+	}
+};
+
+//! Returns the Rice parameter minimizing the code length of values with the given \p mean.
+inline int riceParameter(double mean) {
+	int k = 0;
+	while (k < 40 && (double)(uint64_t(2) << k) <= mean) k++;
+	return k;
+}
+
+//! Writes the difference \p delta of two Rice parameters in zigzag and gamma code.
+inline void writeDelta(BitWriter &out, int delta) {
+	out.writeGamma(delta >= 0 ? 2 * (uint64_t)delta + 1 : 2 * (uint64_t)(-delta));
+}
+
+//! Reads a difference written by writeDelta().
+inline int readDelta(BitReader &in) {
+	uint64_t code = in.readGamma();
+	return code % 2 == 1 ? (int)(code / 2) : -(int)(code / 2);
+}
+
+//! Compressed runs of edges (source, target), each sorted, that are merged into lists of targets per source.
+/**
+ * In successor runs, the targets are at least their sources; in predecessor
+ * runs, at most. A target is coded as its distance to the source if it is
+ * the first of its source and as the gap to the previous target otherwise.
+ */
+class RunList {
+	bool m_predecessors;
+	std::vector<std::vector<uint64_t>> m_runs;
+	std::vector<uint64_t> m_runLength;
+
+	// state of a run while merging: reader, remaining edges, Rice parameter and current edge
+	struct Run {
+		BitReader in;
+		uint64_t remaining;
+		int k;
+		uint32_t source, target;
+	};
+	std::vector<Run> m_readers;
+	using Head = std::pair<std::pair<uint32_t, uint32_t>, size_t>;
+	std::priority_queue<Head, std::vector<Head>, std::greater<Head>> m_heads;
+
+	uint32_t distance(uint32_t source, uint32_t target) const {
+		return m_predecessors ? source - target : target - source;
+	}
+
+	void advance(size_t r) {
+		Run &run = m_readers[r];
+		if (run.remaining == 0) {
+			std::vector<uint64_t>().swap(m_runs[r]);
+			return;
+		}
+		uint32_t source = run.source + (uint32_t)run.in.readGamma() - 1;
+		uint32_t gap = (uint32_t)run.in.readRice(run.k);
+		if (source == run.source && run.remaining != m_runLength[r]) {
+			run.target += gap;
+		} else {
+			run.target = m_predecessors ? source - gap : source + gap;
+		}
+		run.source = source;
+		run.remaining--;
+		m_heads.push(Head(std::make_pair(run.source, run.target), r));
+	}
+
+public:
+	explicit RunList(bool predecessors) : m_predecessors(predecessors) { }
+
+	//! Sorts \p edges and appends them as a run.
+	void append(std::vector<std::pair<uint32_t, uint32_t>> &edges) {
+		std::sort(edges.begin(), edges.end());
+
+		double span = 0;
+		for (const auto &e : edges) {
+			span += (double)distance(e.first, e.second);
+		}
+
+		m_runs.emplace_back();
+		BitWriter out(m_runs.back());
+		int k = riceParameter(span / edges.size());
+		out.write((uint64_t)k, 6);
+
+		uint32_t source = 0, target = 0;
+		for (const auto &e : edges) {
+			out.writeGamma(e.first - source + 1);
+			out.writeRice(e.first == source && &e != &edges.front() ? e.second - target : distance(e.first, e.second), k);
+			source = e.first;
+			target = e.second;
+		}
+		out.close();
+		m_runLength.push_back(edges.size());
+	}
+
+	//! Starts merging the runs.
+	void startMerge() {
+		for (size_t r = 0; r < m_runs.size(); r++) {
+			BitReader in(m_runs[r].data(), 0);
+			int k = (int)in.read(6);
+			m_readers.push_back(Run{in, m_runLength[r], k, 0, 0});
+		}
+		for (size_t r = 0; r < m_readers.size(); r++) {
+			advance(r);
+		}
+	}
+
+	//! Assigns the targets of \p source in increasing order to \p targets; sources must be passed in increasing order.
+	void merge(uint32_t source, std::vector<uint32_t> &targets) {
+		targets.clear();
+		while (!m_heads.empty() && m_heads.top().first.first == source) {
+			targets.push_back(m_heads.top().first.second);
+			size_t r = m_heads.top().second;
+			m_heads.pop();
+			advance(r);
+		}
+	}
+
+	//! Releases the runs after merging.
+	void clear() {
+		m_runs.clear();
+		m_runLength.clear();
+		m_readers.clear();
+	}
+};
+
+}
+
+
+//! Edge sink that builds a compressed, immutable adjacency structure.
+/**
+ * During generation, edges are collected in a buffer of \a runSize edges
+ * which, when full, is sorted and appended in compressed form to a list of
+ * successor runs and a list of predecessor runs; finish() merges the runs
+ * into the final structure. Memory consumption thus stays close to the size
+ * of the compressed graph.
+ *
+ * The final structure holds, for every node v, the list of its predecessors
+ * u <= v and the list of its successors w >= v, so every edge is stored
+ * twice, and one bit offset per 16 nodes. The successor lists alone
+ * represent the graph. A random graph without locality, e.g. from
+ * randomRegularGraph(), needs about log2(n) bits per edge and list, so its
+ * successor lists take 2-3 bytes per edge up to a few million nodes and the
+ * predecessor lists as much again; geometric graphs numbered along
+ * NodeOrder::Hilbert need far less.
+ */
+class CompressedGraphSink : public EdgeSink {
+	static constexpr int s_sampling = 16;
+
+	size_t m_runSize;
+	std::vector<std::pair<uint32_t, uint32_t>> m_buffer;
+	compressed_graph::RunList m_predecessorRuns;
+	compressed_graph::RunList m_successorRuns;
+
+	int m_numberOfNodes;
+	uint64_t m_numberOfEdges;
+	std::vector<uint64_t> m_words;
+	std::vector<uint64_t> m_offsets;
+	uint64_t m_listBits[2];
+
+	//! Sorts the buffer and appends it to the runs.
+	void flushRun() {
+		if (m_buffer.empty()) return;
+		m_successorRuns.append(m_buffer);
+		for (auto &e : m_buffer) {
+			std::swap(e.first, e.second);
+		}
+		m_predecessorRuns.append(m_buffer);
+		m_buffer.clear();
+	}
+
+	//! Reads the header of a list, updating the Rice parameter \p k of the previous list; returns the length of the list.
+	static uint64_t readHeader(compressed_graph::BitReader &in, int &k) {
+		uint64_t count = in.readGamma() - 1;
+		if (count > 0) {
+			k += compressed_graph::readDelta(in);
+		}
+		return count;
+	}
+
+	//! Returns a reader at the lists of node \p v and sets \p k to the Rice parameters of the preceding lists.
+	compressed_graph::BitReader seek(int v, int k[2]) const {
+		compressed_graph::BitReader in(m_words.data(), m_offsets[v / s_sampling]);
+		k[0] = k[1] = 0;
+		for (int u = v - v % s_sampling; u < v; u++) {
+			for (int list = 0; list < 2; list++) {
+				for (uint64_t i = readHeader(in, k[list]); i > 0; i--) {
+					in.readRice(k[list]);
+				}
+			}
+		}
+		return in;
+	}
+
+	//! Reads the predecessor list of \p v and calls \p f(u) for every predecessor u in increasing order.
+	template<typename F>
+	static void readPredecessors(compressed_graph::BitReader &in, int v, int &k, F f) {
+		uint64_t count = readHeader(in, k);
+		uint32_t u = (uint32_t)v;
+		for (uint64_t i = 0; i < count; i++) {
+			uint32_t gap = (uint32_t)in.readRice(k);
+			u = i == 0 ? u - gap : u + gap;
+			f((int)u);
+		}
+	}
+
+	//! Reads the successor list of \p v and calls \p f(w) for every successor w in increasing order.
+	template<typename F>
+	static void readSuccessors(compressed_graph::BitReader &in, int v, int &k, F f) {
+		uint64_t count = readHeader(in, k);
+		uint32_t w = (uint32_t)v;
+		for (uint64_t i = 0; i < count; i++) {
+			w += (uint32_t)in.readRice(k);
+			f((int)w);
+		}
+	}
+
+public:
+	//! Creates a sink that compresses the collected edges whenever \p runSize have been added.
+	explicit CompressedGraphSink(size_t runSize = 1 << 22)
+		: m_runSize(runSize), m_predecessorRuns(true), m_successorRuns(false),
+		  m_numberOfNodes(0), m_numberOfEdges(0), m_listBits{0, 0}
+	{
+		m_buffer.reserve(m_runSize);
+	}
+
+	int addNode() override {
+		return m_numberOfNodes++;
+	}
+
+	using EdgeSink::addEdge;
+
+	void addEdge(int u, int v) override {
+		m_buffer.emplace_back((uint32_t)std::min(u, v), (uint32_t)std::max(u, v));
+		m_numberOfEdges++;
+		if (m_buffer.size() == m_runSize) {
+			flushRun();
+		}
+	}
+
+	//! Merges the runs into the final structure.
+	void finish() override {
+		flushRun();
+		std::vector<std::pair<uint32_t, uint32_t>>().swap(m_buffer);
+		m_predecessorRuns.startMerge();
+		m_successorRuns.startMerge();
+
+		compressed_graph::BitWriter out(m_words);
+		m_offsets.assign((size_t)m_numberOfNodes / s_sampling + 1, 0);
+		std::vector<uint32_t> targets;
+		int k[2] = {0, 0};
+
+		// the Rice parameter of a list is coded as the difference to the one of the previous list of the same kind
+		for (int v = 0; v < m_numberOfNodes; v++) {
+			if (v % s_sampling == 0) {
+				m_offsets[v / s_sampling] = out.position();
+				k[0] = k[1] = 0;
+			}
+			for (int list = 0; list < 2; list++) {
+				uint64_t start = out.position();
+				if (list == 0) {
+					m_predecessorRuns.merge((uint32_t)v, targets);
+				} else {
+					m_successorRuns.merge((uint32_t)v, targets);
+				}
+
+				out.writeGamma(targets.size() + 1);
+				if (!targets.empty()) {
+					// predecessors start with the distance to the smallest one, successors with the distance to v
+					uint32_t span = list == 0 ? v - targets.front() : targets.back() - v;
+					int kList = compressed_graph::riceParameter((double)span / targets.size());
+					compressed_graph::writeDelta(out, kList - k[list]);
+					k[list] = kList;
+
+					out.writeRice(list == 0 ? v - targets.front() : targets.front() - v, kList);
+					for (size_t i = 1; i < targets.size(); i++) {
+						out.writeRice(targets[i] - targets[i - 1], kList);
+					}
+				}
+				m_listBits[list] += out.position() - start;
+			}
+		}
+		out.close();
+
+		m_predecessorRuns.clear();
+		m_successorRuns.clear();
+	}
+
+	//! Returns the number of nodes.
+	int numberOfNodes() const { return m_numberOfNodes; }
+
+	//! Returns the number of edges.
+	uint64_t numberOfEdges() const { return m_numberOfEdges; }
+
+	//! Returns the degree of node \p v, in which self-loops count twice; only valid after finish().
+	uint64_t degree(int v) const {
+		int k[2] = {0, 0};
+		compressed_graph::BitReader in = seek(v, k);
+		uint64_t degree = readHeader(in, k[0]);
+		for (uint64_t i = degree; i > 0; i--) {
+			in.readRice(k[0]);
+		}
+		return degree + readHeader(in, k[1]);
+	}
+
+	//! Calls \p f(w) for every neighbor w of \p v in increasing order; only valid after finish().
+	/**
+	 * A self-loop at \p v yields \p v twice, like CsrSink.
+	 */
+	template<typename F>
+	void forEachNeighbor(int v, F f) const {
+		int k[2] = {0, 0};
+		compressed_graph::BitReader in = seek(v, k);
+		readPredecessors(in, v, k[0], f);
+		readSuccessors(in, v, k[1], f);
+	}
+
+	//! Calls \p f(w) for every neighbor w >= \p v of \p v in increasing order; only valid after finish().
+	template<typename F>
+	void forEachSuccessor(int v, F f) const {
+		int k[2] = {0, 0};
+		compressed_graph::BitReader in = seek(v, k);
+		readPredecessors(in, v, k[0], [](int) { });
+		readSuccessors(in, v, k[1], f);
+	}
+
+	//! Calls \p f(u, v), u <= v, for all edges in lexicographical order; only valid after finish().
+	template<typename F>
+	void forEachEdge(F f) const {
+		compressed_graph::BitReader in(m_words.data(), 0);
+		int k[2] = {0, 0};
+		for (int u = 0; u < m_numberOfNodes; u++) {
+			if (u % s_sampling == 0) {
+				k[0] = k[1] = 0;
+			}
+			readPredecessors(in, u, k[0], [](int) { });
+			readSuccessors(in, u, k[1], [&](int w) { f(u, w); });
+		}
+	}
+
+	//! Returns the memory occupied by the final structure in bytes.
+	size_t sizeInBytes() const {
+		return m_words.size() * sizeof(uint64_t) + m_offsets.size() * sizeof(uint64_t);
+	}
+
+	//! Returns the memory occupied by the predecessor lists in bytes.
+	size_t predecessorBytes() const {
+		return (size_t)((m_listBits[0] + 7) / 8);
+	}
+
+	//! Returns the memory occupied by the successor lists in bytes, which alone represent the graph.
+	size_t successorBytes() const {
+		return (size_t)((m_listBits[1] + 7) / 8);
+	}
+};
+
+}
@@ -0,0 +1,327 @@
+/** \file
+ * \brief Declaration of a compact binary edge list file format, its writer and its reader.
+ *
+ * A file consists of a header of EdgeListFileHeader::size bytes followed by
+ * the edges, each of which is stored as two unsigned 32-bit node indices in
+ * the byte order of the writing machine. The header records the model, its
+ * parameters, the seed and the numbers of nodes and edges, so that a file
+ * documents how it was generated.
+ *
+ * The writer streams the edges through a large aligned buffer, using
+ * O_DIRECT where the file system supports it, so arbitrarily large graphs
+ * can be generated at full I/O bandwidth without keeping them in memory.
+ * The reader memory-maps a file and replays it into an EdgeSink or builds
+ * a CsrSink directly from the mapping.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "EdgeSink.h"
+
+namespace ogdf {
+
+//! Header of a binary edge list file.
+struct EdgeListFileHeader {
+	//! Size of the header in bytes; edges start at this offset, which keeps them block aligned.
+	static constexpr size_t size = 4096;
+
+	//! Identifies the file format.
+	static const char *magic() { return "OGDFEDGE"; }
+
+	static constexpr uint32_t currentVersion = 1;
+
+	//! Written as is, to detect files from machines with a different byte order.
+	static constexpr uint32_t byteOrderMark = 0x01020304;
+
+	char magicBytes[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint64_t numberOfNodes;
+	uint64_t numberOfEdges;
+	uint64_t seed;
+	char model[64];
+	char parameters[size - 104];
+};
+
+static_assert(sizeof(EdgeListFileHeader) == EdgeListFileHeader::size, "unexpected padding in EdgeListFileHeader");
+
+
+//! Edge sink that streams the edges into a binary edge list file.
+/**
+ * Nodes and edges are only counted and the edges written out, so memory
+ * consumption is independent of the size of the graph. The header is
+ * completed by finish(); check good() afterwards.
+ *
+ * \code
+ * setSeed(seed);
+ * EdgeListFileSink file("chunglu.bin", "chung-lu", "n=1000000 w=20", seed);
+ * randomChungLuGraph(file, weights);
+ * if (!file.good()) ...
+ * \endcode
+ */
+class EdgeListFileSink : public EdgeSink {
+	static constexpr size_t s_alignment = 4096;
+
+	int m_fd;
+	bool m_direct;
+	bool m_failed;
+	EdgeListFileHeader *m_header;
+	char *m_buffer;
+	size_t m_bufferSize;
+	size_t m_filled;
+	uint64_t m_offset;
+	uint64_t m_numberOfNodes;
+	uint64_t m_numberOfEdges;
+
+	//! Writes \p length bytes at the current offset; \p length is a multiple of the alignment unless buffered.
+	void write(const char *data, size_t length) {
+		while (length > 0 && !m_failed) {
+			ssize_t written = ::pwrite(m_fd, data, length, (off_t)m_offset);
+			if (written <= 0) {
+				m_failed = true;
+				return;
+			}
+			data += written;
+			length -= (size_t)written;
+			m_offset += (uint64_t)written;
+		}
+	}
+
+	void flushBuffer() {
+		size_t full = m_direct ? m_filled / s_alignment * s_alignment : m_filled;
+		write(m_buffer, full);
+		memmove(m_buffer, m_buffer + full, m_filled - full);
+		m_filled -= full;
+	}
+
+public:
+	//! Creates the file \p path and records \p model, \p parameters and \p seed in its header.
+	/**
+	 * @param path is the file to be written; it is replaced if it exists.
+	 * @param model names the generator.
+	 * @param parameters describes the parameters of the generator.
+	 * @param seed is the seed the generator was run with.
+	 * @param bufferSize is the size of the write buffer in bytes.
+	 */
+	EdgeListFileSink(const std::string &path, const std::string &model, const std::string &parameters,
+			uint64_t seed, size_t bufferSize = 16 << 20)
+		: m_fd(-1), m_direct(false), m_failed(false), m_header(nullptr), m_buffer(nullptr),
+		  m_bufferSize((bufferSize + s_alignment - 1) / s_alignment * s_alignment),
+		  m_filled(0), m_offset(0), m_numberOfNodes(0), m_numberOfEdges(0)
+	{
+#ifdef O_DIRECT
+		m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+		m_direct = m_fd >= 0;
+#endif
+		if (m_fd < 0) {
+			m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		}
+
+		void *header = nullptr, *buffer = nullptr;
+		if (m_fd < 0
+		 || posix_memalign(&header, s_alignment, EdgeListFileHeader::size) != 0
+		 || posix_memalign(&buffer, s_alignment, m_bufferSize) != 0) {
+			free(header);
+			m_failed = true;
+			return;
+		}
+		m_header = static_cast<EdgeListFileHeader *>(header);
+		m_buffer = static_cast<char *>(buffer);
+
+		memset(m_header, 0, EdgeListFileHeader::size);
+		memcpy(m_header->magicBytes, EdgeListFileHeader::magic(), sizeof(m_header->magicBytes));
+		m_header->version = EdgeListFileHeader::currentVersion;
+		m_header->byteOrder = EdgeListFileHeader::byteOrderMark;
+		m_header->seed = seed;
+		strncpy(m_header->model, model.c_str(), sizeof(m_header->model) - 1);
+		strncpy(m_header->parameters, parameters.c_str(), sizeof(m_header->parameters) - 1);
+
+		// the header is rewritten with the final counts by finish()
+		write(reinterpret_cast<const char *>(m_header), EdgeListFileHeader::size);
+	}
+
+	EdgeListFileSink(const EdgeListFileSink &) = delete;
+	EdgeListFileSink &operator=(const EdgeListFileSink &) = delete;
+
+	~EdgeListFileSink() {
+		if (m_fd >= 0) {
+			::close(m_fd);
+		}
+		free(m_buffer);
+		free(m_header);
+	}
+
+	int addNode() override {
+		return (int)m_numberOfNodes++;
+	}
+
+	using EdgeSink::addEdge;
+
+	void addEdge(int u, int v) override {
+		if (m_failed) return;
+
+		uint32_t ends[2] = { (uint32_t)u, (uint32_t)v };
+		if (m_filled + sizeof(ends) > m_bufferSize) {
+			flushBuffer();
+		}
+		memcpy(m_buffer + m_filled, ends, sizeof(ends));
+		m_filled += sizeof(ends);
+		m_numberOfEdges++;
+	}
+
+	//! Writes the remaining edges and completes the header.
+	void finish() override {
+		if (m_failed) return;
+
+		flushBuffer();
+		uint64_t length = m_offset + m_filled;
+		if (m_filled > 0) {
+			// O_DIRECT only writes whole blocks, the padding is truncated below
+			size_t padded = m_direct ? (m_filled + s_alignment - 1) / s_alignment * s_alignment : m_filled;
+			memset(m_buffer + m_filled, 0, padded - m_filled);
+			write(m_buffer, padded);
+			m_filled = 0;
+		}
+
+		m_header->numberOfNodes = m_numberOfNodes;
+		m_header->numberOfEdges = m_numberOfEdges;
+		m_offset = 0;
+		write(reinterpret_cast<const char *>(m_header), EdgeListFileHeader::size);
+
+		if (::ftruncate(m_fd, (off_t)length) != 0 || ::fsync(m_fd) != 0) {
+			m_failed = true;
+		}
+		m_offset = length;
+	}
+
+	//! Returns false if the file could not be created or written.
+	bool good() const { return !m_failed; }
+
+	//! Returns true if the file is written with O_DIRECT, in whole blocks.
+	bool direct() const { return m_direct; }
+
+	//! Returns the number of edges added.
+	uint64_t numberOfEdges() const { return m_numberOfEdges; }
+};
+
+
+//! Read-only, memory-mapped binary edge list file.
+class EdgeListFile {
+	int m_fd;
+	void *m_data;
+	size_t m_length;
+	const EdgeListFileHeader *m_header;
+
+public:
+	EdgeListFile() : m_fd(-1), m_data(nullptr), m_length(0), m_header(nullptr) { }
+
+	EdgeListFile(const EdgeListFile &) = delete;
+	EdgeListFile &operator=(const EdgeListFile &) = delete;
+
+	~EdgeListFile() {
+		close();
+	}
+
+	//! Maps the file \p path; returns false if it cannot be read or is not a valid edge list file.
+	bool open(const std::string &path) {
+		close();
+
+		m_fd = ::open(path.c_str(), O_RDONLY);
+		struct stat info;
+		if (m_fd < 0 || fstat(m_fd, &info) != 0 || (size_t)info.st_size < EdgeListFileHeader::size) {
+			close();
+			return false;
+		}
+
+		m_length = (size_t)info.st_size;
+		m_data = mmap(nullptr, m_length, PROT_READ, MAP_SHARED, m_fd, 0);
+		if (m_data == MAP_FAILED) {
+			m_data = nullptr;
+			close();
+			return false;
+		}
+		m_header = static_cast<const EdgeListFileHeader *>(m_data);
+
+		if (memcmp(m_header->magicBytes, EdgeListFileHeader::magic(), sizeof(m_header->magicBytes)) != 0
+		 || m_header->version != EdgeListFileHeader::currentVersion
+		 || m_header->byteOrder != EdgeListFileHeader::byteOrderMark
+		 || m_length != EdgeListFileHeader::size + 2 * sizeof(uint32_t) * m_header->numberOfEdges) {
+			close();
+			return false;
+		}
+
+		// edges are read once front to back
+		madvise(m_data, m_length, MADV_SEQUENTIAL);
+		return true;
+	}
+
+	//! Unmaps the file.
+	void close() {
+		if (m_data != nullptr) {
+			munmap(m_data, m_length);
+		}
+		if (m_fd >= 0) {
+			::close(m_fd);
+		}
+		m_fd = -1;
+		m_data = nullptr;
+		m_length = 0;
+		m_header = nullptr;
+	}
+
+	//! Returns the header of the open file.
+	const EdgeListFileHeader &header() const { return *m_header; }
+
+	//! Returns the number of nodes.
+	uint64_t numberOfNodes() const { return m_header->numberOfNodes; }
+
+	//! Returns the number of edges.
+	uint64_t numberOfEdges() const { return m_header->numberOfEdges; }
+
+	//! Returns the endpoints of the edges; the e-th edge is {ends()[2e], ends()[2e+1]}.
+	const uint32_t *ends() const {
+		return reinterpret_cast<const uint32_t *>(static_cast<const char *>(m_data) + EdgeListFileHeader::size);
+	}
+
+	//! Adds the nodes and edges of the file to \p sink, e.g. a GraphSink.
+	void replay(EdgeSink &sink) const {
+		const uint32_t *e = ends();
+		sink.reserve((int)numberOfNodes(), (long long)numberOfEdges());
+		for (uint64_t i = 0; i < numberOfNodes(); i++) {
+			sink.addNode();
+		}
+		for (uint64_t i = 0; i < numberOfEdges(); i++) {
+			sink.addEdge((int)e[2 * i], (int)e[2 * i + 1]);
+		}
+		sink.finish();
+	}
+
+	//! Builds the CSR representation in \p csr directly from the mapping.
+	void toCsr(CsrSink &csr) const {
+		csr.assign((int)numberOfNodes(), ends(), numberOfEdges());
+	}
+};
+
+
+//! Reads the edge list file \p path into \p G; returns false if the file cannot be read.
+inline bool readEdgeListFile(const std::string &path, Graph &G) {
+	EdgeListFile file;
+	if (!file.open(path)) return false;
+
+	G.clear();
+	GraphSink sink(G);
+	file.replay(sink);
+	return true;
+}
+
+}
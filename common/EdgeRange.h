@@ -0,0 +1,229 @@
+/** \file
+ * \brief Declaration of EdgeRange, a lazily evaluated range of generated edges.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "EdgeSink.h"
+#include "Parallel.h"
+#include "Random.h"
+
+namespace ogdf {
+
+//! Lazily evaluated, single-pass range of the edges produced by a generator.
+/**
+ * The generator runs on a separate thread and writes into a bounded buffer
+ * of edge blocks; it is suspended whenever the buffer is full. Hence the
+ * memory consumption is bounded by the buffer and the state of the model,
+ * generation overlaps with consumption, and destroying the range before the
+ * end is reached stops the generator without producing the remaining edges.
+ * The generator draws its seeds from the SeedScope active where the range
+ * is created, so it generates the same edges as if it was called there.
+ *
+ * \code
+ * EdgeRange edges([&](EdgeSink &sink) { randomChungLuGraph(sink, weights); });
+ * for (const std::pair<int, int> &e : edges) {
+ *     if (!simulate(e.first, e.second)) break;
+ * }
+ * \endcode
+ */
+class EdgeRange {
+public:
+	using Edge = std::pair<int, int>;
+
+private:
+	//! Thrown inside the generator thread when the consumer has stopped.
+	struct Cancelled { };
+
+	//! State shared with the generator thread.
+	struct Channel {
+		std::mutex mutex;
+		std::condition_variable changed;
+		std::deque<std::vector<Edge>> blocks;
+		size_t maxBlocks;
+		bool done = false;
+		bool cancelled = false;
+		std::exception_ptr error;
+		std::atomic<int> numberOfNodes{0};
+
+		explicit Channel(size_t maxBlocksInFlight) : maxBlocks(maxBlocksInFlight) { }
+
+		void push(std::vector<Edge> &block) {
+			std::unique_lock<std::mutex> lock(mutex);
+			changed.wait(lock, [this] { return cancelled || blocks.size() < maxBlocks; });
+			if (cancelled) throw Cancelled();
+			blocks.push_back(std::move(block));
+			changed.notify_all();
+		}
+
+		bool pop(std::vector<Edge> &block) {
+			std::unique_lock<std::mutex> lock(mutex);
+			changed.wait(lock, [this] { return done || !blocks.empty(); });
+			if (blocks.empty()) return false;
+			block = std::move(blocks.front());
+			blocks.pop_front();
+			changed.notify_all();
+			return true;
+		}
+	};
+
+	//! Sink collecting the edges of the generator in blocks.
+	class ChannelSink : public EdgeSink {
+		Channel &m_channel;
+		std::vector<Edge> m_block;
+		size_t m_blockSize;
+
+	public:
+		ChannelSink(Channel &channel, size_t blockSize) : m_channel(channel), m_blockSize(blockSize) {
+			m_block.reserve(m_blockSize);
+		}
+
+		int addNode() override {
+			return m_channel.numberOfNodes++;
+		}
+
+		using EdgeSink::addEdge;
+
+		void addEdge(int u, int v) override {
+			m_block.emplace_back(u, v);
+			if (m_block.size() == m_blockSize) {
+				flush();
+			}
+		}
+
+		void flush() {
+			if (!m_block.empty()) {
+				m_channel.push(m_block);
+				m_block.clear();
+				m_block.reserve(m_blockSize);
+			}
+		}
+	};
+
+	std::unique_ptr<Channel> m_channel;
+	std::thread m_thread;
+	std::vector<Edge> m_block;
+	size_t m_next = 0;
+	bool m_started = false;
+
+	//! Advances to the next edge; returns false at the end of the range.
+	bool advance() {
+		if (++m_next < m_block.size()) return true;
+		m_next = 0;
+		m_block.clear();
+		while (m_block.empty()) {
+			if (!m_channel->pop(m_block)) {
+				if (m_channel->error) {
+					std::rethrow_exception(m_channel->error);
+				}
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	//! Input iterator over an EdgeRange; the end iterator has no range.
+	class iterator {
+		EdgeRange *m_range;
+
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = Edge;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Edge *;
+		using reference = const Edge &;
+
+		explicit iterator(EdgeRange *range = nullptr) : m_range(range) { }
+
+		reference operator*() const { return m_range->m_block[m_range->m_next]; }
+		pointer operator->() const { return &**this; }
+
+		iterator &operator++() {
+			if (!m_range->advance()) m_range = nullptr;
+			return *this;
+		}
+
+		void operator++(int) { ++*this; }
+
+		bool operator==(const iterator &other) const { return m_range == other.m_range; }
+		bool operator!=(const iterator &other) const { return m_range != other.m_range; }
+	};
+
+	//! Creates the range of edges that \p generate adds to the sink it is called with.
+	/**
+	 * @param generate is called with an EdgeSink on the generator thread.
+	 * @param blockSize is the number of edges handed over at once.
+	 * @param maxBlocks is the number of blocks that may be generated ahead of the consumer.
+	 */
+	explicit EdgeRange(std::function<void(EdgeSink &)> generate, size_t blockSize = 4096, size_t maxBlocks = 4)
+		: m_channel(new Channel(maxBlocks))
+	{
+		Channel *channel = m_channel.get();
+		SeedState seeds = seedState();
+		int limit = threadLimit();
+		m_thread = std::thread([channel, blockSize, generate, seeds, limit]() {
+			// the generator runs in the SeedScope and ThreadLimit of the constructing thread
+			seedState() = seeds;
+			threadLimit() = limit;
+			try {
+				ChannelSink sink(*channel, blockSize);
+				generate(sink);
+				sink.flush();
+			} catch (const Cancelled &) {
+			} catch (...) {
+				channel->error = std::current_exception();
+			}
+
+			std::lock_guard<std::mutex> lock(channel->mutex);
+			channel->done = true;
+			channel->changed.notify_all();
+		});
+	}
+
+	EdgeRange(const EdgeRange &) = delete;
+	EdgeRange &operator=(const EdgeRange &) = delete;
+
+	//! Stops the generator if it has not finished yet.
+	~EdgeRange() {
+		{
+			std::lock_guard<std::mutex> lock(m_channel->mutex);
+			m_channel->cancelled = true;
+			m_channel->changed.notify_all();
+		}
+		m_thread.join();
+	}
+
+	//! Returns an iterator to the first edge; may only be called once.
+	iterator begin() {
+		OGDF_ASSERT(!m_started);
+		m_started = true;
+		m_next = m_block.size();
+		return iterator(advance() ? this : nullptr);
+	}
+
+	//! Returns the end iterator.
+	iterator end() { return iterator(); }
+
+	//! Returns the number of nodes the generator has added so far.
+	/**
+	 * All generators add their nodes before their edges, except for those
+	 * that grow a graph node by node, like preferentialAttachmentGraph().
+	 */
+	int numberOfNodes() const { return m_channel->numberOfNodes; }
+};
+
+}
@@ -0,0 +1,356 @@
+/** \file
+ * \brief Declaration of edge sinks, the output targets of the random graph generators.
+ *
+ * A generator reports its nodes and edges to an EdgeSink instead of building
+ * an ogdf::Graph itself. Nodes are identified by the consecutive indices
+ * returned by EdgeSink::addNode(), edges are undirected.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/EdgeArray.h>
+#include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include "Parallel.h"
+
+namespace ogdf {
+
+//! Interface for the output of random graph generators.
+class EdgeSink {
+public:
+	virtual ~EdgeSink() { }
+
+	//! Announces that \p n nodes and about \p m edges will be added; \p m is 0 if unknown.
+	virtual void reserve(int /* n */, long long /* m */) { }
+
+	//! Adds a new node and returns its index.
+	virtual int addNode() = 0;
+
+	//! Adds the edge between the nodes with indices \p u and \p v.
+	virtual void addEdge(int u, int v) = 0;
+
+	//! Adds the edge between \p u and \p v with the given \p cost, e.g. the distance of its endpoints.
+	/**
+	 * Sinks that do not store edge costs ignore them.
+	 */
+	virtual void addEdge(int u, int v, double /* cost */) {
+		addEdge(u, v);
+	}
+
+	//! Places the node with index \p v at the point with the \p dimension coordinates \p position.
+	/**
+	 * Geometric generators call this once for every node. Sinks that do not
+	 * store positions ignore it.
+	 */
+	virtual void setPosition(int /* v */, const double * /* position */, int /* dimension */) { }
+
+	//! Is called by the generator after all nodes and edges have been added.
+	virtual void finish() { }
+};
+
+
+//! Edge sink that adds nodes and edges to an ogdf::Graph.
+/**
+ * Nodes already present in the graph keep their order and are assigned the
+ * first indices, so generators that extend a graph can refer to them.
+ *
+ * New nodes and edges are buffered in flat arrays during generation and
+ * inserted in bulk by finish(): all nodes first, then the edges ordered by
+ * source with a counting sort, which runs on up to generatorThreads()
+ * threads for dense graphs. This keeps random number generation and list
+ * manipulation apart, and the adjacency lists of consecutive sources are
+ * built one after the other instead of in the scattered order in which the
+ * generator found the edges.
+ */
+class GraphSink : public EdgeSink {
+	Graph &m_G;
+	ArrayBuffer<node> m_nodes;
+	EdgeArray<double> *m_cost;
+	GraphAttributes *m_attributes;
+	int m_numberOfNodes;
+	std::vector<std::pair<uint32_t, uint32_t>> m_edges;
+	std::vector<double> m_costs;
+	//! x, y and z of every node placed by setPosition(), by index.
+	std::vector<std::pair<int, std::array<double, 3>>> m_positions;
+
+	//! Sorts the edges and their costs stably by source.
+	void sortBySource() {
+		size_t m = m_edges.size();
+		size_t n = (size_t)m_numberOfNodes;
+
+		// every thread needs its own counters, which only pays off if there are many edges per node
+		int threads = parallelChunks(m, 4 * n + 1);
+
+		std::vector<std::vector<size_t>> start(threads, std::vector<size_t>(n + 1, 0));
+		parallelFor(m, threads, [&](int t, size_t begin, size_t end) {
+			std::vector<size_t> &count = start[t];
+			for (size_t e = begin; e < end; e++) {
+				count[m_edges[e].first]++;
+			}
+		});
+
+		// edges of source v from thread t follow those of v from threads 0, ..., t-1
+		size_t offset = 0;
+		for (size_t v = 0; v < n; v++) {
+			for (int t = 0; t < threads; t++) {
+				size_t count = start[t][v];
+				start[t][v] = offset;
+				offset += count;
+			}
+		}
+
+		std::vector<std::pair<uint32_t, uint32_t>> edges(m);
+		std::vector<double> costs(m_costs.size());
+		parallelFor(m, threads, [&](int t, size_t begin, size_t end) {
+			std::vector<size_t> &next = start[t];
+			for (size_t e = begin; e < end; e++) {
+				size_t position = next[m_edges[e].first]++;
+				edges[position] = m_edges[e];
+				if (!costs.empty()) {
+					costs[position] = m_costs[e];
+				}
+			}
+		});
+
+		m_edges.swap(edges);
+		m_costs.swap(costs);
+	}
+
+public:
+	//! Creates a sink for \p G; if \p cost is given, it is assigned the cost of each new edge.
+	/**
+	 * If \p attributes, which must belong to \p G, are given, they are
+	 * assigned the positions of the nodes: the first two coordinates as x
+	 * and y, and the third as z if the attributes have GraphAttributes::threeD.
+	 */
+	explicit GraphSink(Graph &G, EdgeArray<double> *cost = nullptr, GraphAttributes *attributes = nullptr)
+		: m_G(G), m_cost(cost), m_attributes(attributes), m_numberOfNodes(0)
+	{
+		OGDF_ASSERT(m_attributes == nullptr || &m_attributes->constGraph() == &G);
+		for (node v : G.nodes) {
+			m_nodes.push(v);
+			m_numberOfNodes++;
+		}
+		if (m_cost != nullptr) {
+			m_cost->init(G);
+		}
+	}
+
+	void reserve(int /* n */, long long m) override {
+		m_edges.reserve((size_t)m);
+		if (m_cost != nullptr) {
+			m_costs.reserve((size_t)m);
+		}
+	}
+
+	int addNode() override {
+		return m_numberOfNodes++;
+	}
+
+	void addEdge(int u, int v) override {
+		m_edges.emplace_back((uint32_t)u, (uint32_t)v);
+		if (m_cost != nullptr) {
+			m_costs.push_back(0.0);
+		}
+	}
+
+	void addEdge(int u, int v, double cost) override {
+		m_edges.emplace_back((uint32_t)u, (uint32_t)v);
+		if (m_cost != nullptr) {
+			m_costs.push_back(cost);
+		}
+	}
+
+	void setPosition(int v, const double *position, int dimension) override {
+		if (m_attributes != nullptr) {
+			std::array<double, 3> xyz = {0.0, 0.0, 0.0};
+			std::copy(position, position + std::min(dimension, 3), xyz.begin());
+			m_positions.emplace_back(v, xyz);
+		}
+	}
+
+	//! Inserts the buffered nodes and edges into the graph.
+	void finish() override {
+		while (m_nodes.size() < m_numberOfNodes) {
+			m_nodes.push(m_G.newNode());
+		}
+
+		if (m_attributes != nullptr) {
+			bool threeD = m_attributes->has(GraphAttributes::threeD);
+			for (const auto &position : m_positions) {
+				node v = m_nodes[position.first];
+				m_attributes->x(v) = position.second[0];
+				m_attributes->y(v) = position.second[1];
+				if (threeD) {
+					m_attributes->z(v) = position.second[2];
+				}
+			}
+			std::vector<std::pair<int, std::array<double, 3>>>().swap(m_positions);
+		}
+
+		sortBySource();
+
+		for (size_t e = 0; e < m_edges.size(); e++) {
+			edge f = m_G.newEdge(m_nodes[m_edges[e].first], m_nodes[m_edges[e].second]);
+			if (m_cost != nullptr) {
+				(*m_cost)[f] = m_costs[e];
+			}
+		}
+
+		std::vector<std::pair<uint32_t, uint32_t>>().swap(m_edges);
+		std::vector<double>().swap(m_costs);
+	}
+
+	//! Returns the node with index \p i; nodes added by the generator only exist after finish().
+	node nodeOf(int i) const { return m_nodes[i]; }
+};
+
+
+//! Edge sink that appends the edges to a flat list of index pairs.
+class EdgeListSink : public EdgeSink {
+	std::vector<std::pair<uint32_t, uint32_t>> &m_edges;
+	int m_numberOfNodes;
+
+public:
+	//! Creates a sink that appends to \p edges.
+	explicit EdgeListSink(std::vector<std::pair<uint32_t, uint32_t>> &edges)
+		: m_edges(edges), m_numberOfNodes(0) { }
+
+	void reserve(int /* n */, long long m) override {
+		m_edges.reserve(m_edges.size() + (size_t)m);
+	}
+
+	int addNode() override {
+		return m_numberOfNodes++;
+	}
+
+	using EdgeSink::addEdge;
+
+	void addEdge(int u, int v) override {
+		m_edges.emplace_back((uint32_t)u, (uint32_t)v);
+	}
+
+	//! Returns the number of nodes added.
+	int numberOfNodes() const { return m_numberOfNodes; }
+};
+
+
+//! Edge sink that builds a symmetric compressed sparse row representation.
+/**
+ * Edges are buffered during generation. finish() sorts them by source with
+ * a counting sort, such that the neighbors of node \a v are
+ * targets()[offsets()[v]] ... targets()[offsets()[v+1]-1].
+ * Every edge occurs in the neighborhoods of both of its endpoints.
+ */
+class CsrSink : public EdgeSink {
+	std::vector<std::pair<uint32_t, uint32_t>> m_edges;
+	std::vector<uint64_t> m_offsets;
+	std::vector<uint32_t> m_targets;
+	int m_numberOfNodes;
+
+	//! Sorts the edges \p edgeAt(0), ..., \p edgeAt(m-1) into neighborhoods with a counting sort.
+	template<typename EdgeAt>
+	void build(int n, size_t m, EdgeAt edgeAt) {
+		m_offsets.assign((size_t)n + 1, 0);
+		for (size_t e = 0; e < m; e++) {
+			std::pair<uint32_t, uint32_t> uv = edgeAt(e);
+			m_offsets[uv.first + 1]++;
+			m_offsets[uv.second + 1]++;
+		}
+		for (int v = 0; v < n; v++) {
+			m_offsets[v + 1] += m_offsets[v];
+		}
+
+		std::vector<uint64_t> fill(m_offsets.begin(), m_offsets.end() - 1);
+		m_targets.resize(2 * m);
+		for (size_t e = 0; e < m; e++) {
+			std::pair<uint32_t, uint32_t> uv = edgeAt(e);
+			m_targets[fill[uv.first]++] = uv.second;
+			m_targets[fill[uv.second]++] = uv.first;
+		}
+	}
+
+public:
+	CsrSink() : m_numberOfNodes(0) { }
+
+	void reserve(int /* n */, long long m) override {
+		m_edges.reserve((size_t)m);
+	}
+
+	int addNode() override {
+		return m_numberOfNodes++;
+	}
+
+	using EdgeSink::addEdge;
+
+	void addEdge(int u, int v) override {
+		m_edges.emplace_back((uint32_t)u, (uint32_t)v);
+	}
+
+	void finish() override {
+		build(m_numberOfNodes, m_edges.size(), [this](size_t e) { return m_edges[e]; });
+		std::vector<std::pair<uint32_t, uint32_t>>().swap(m_edges);
+	}
+
+	//! Builds the representation of the graph with \p n nodes and \p m edges.
+	/**
+	 * The endpoints of the e-th edge are \p ends[2e] and \p ends[2e+1].
+	 * Replaces everything added so far.
+	 */
+	void assign(int n, const uint32_t *ends, uint64_t m) {
+		m_edges.clear();
+		m_numberOfNodes = n;
+		build(n, (size_t)m, [ends](size_t e) { return std::make_pair(ends[2 * e], ends[2 * e + 1]); });
+	}
+
+	//! Returns the number of nodes.
+	int numberOfNodes() const { return m_numberOfNodes; }
+
+	//! Returns the number of edges; only valid after finish().
+	uint64_t numberOfEdges() const { return m_targets.size() / 2; }
+
+	//! Returns the degree of node \p v; only valid after finish().
+	uint64_t degree(int v) const { return m_offsets[v + 1] - m_offsets[v]; }
+
+	//! Returns the offsets of the neighborhoods in targets().
+	const std::vector<uint64_t> &offsets() const { return m_offsets; }
+
+	//! Returns the concatenated neighborhoods of all nodes.
+	const std::vector<uint32_t> &targets() const { return m_targets; }
+};
+
+
+//! Edge sink that only counts nodes and edges.
+class CountingSink : public EdgeSink {
+	int m_numberOfNodes;
+	long long m_numberOfEdges;
+
+public:
+	CountingSink() : m_numberOfNodes(0), m_numberOfEdges(0) { }
+
+	int addNode() override {
+		return m_numberOfNodes++;
+	}
+
+	using EdgeSink::addEdge;
+
+	void addEdge(int /* u */, int /* v */) override {
+		m_numberOfEdges++;
+	}
+
+	//! Returns the number of nodes added.
+	int numberOfNodes() const { return m_numberOfNodes; }
+
+	//! Returns the number of edges added.
+	long long numberOfEdges() const { return m_numberOfEdges; }
+};
+
+}
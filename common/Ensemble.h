@@ -0,0 +1,193 @@
+/** \file
+ * \brief Declaration of Ensemble, which generates many independent samples of a model in parallel.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+
+#include "EdgeSink.h"
+#include "Parallel.h"
+#include "Random.h"
+#include "ScratchArena.h"
+
+namespace ogdf {
+
+//! Thread pool generating ensembles of random graphs.
+/**
+ * A model is a generator with bound parameters. Sample \a i of an ensemble
+ * with base seed \a seed is generated inside a SeedScope(seed, i), so it is
+ * the same graph no matter which worker generates it, and
+ * generateSample() reproduces it on its own.
+ *
+ * The workers and their scratch buffers persist across calls of
+ * generate(). Every worker installs its own ScratchArena while generating,
+ * so after the first samples the generators' temporaries need no further
+ * heap allocations.
+ *
+ * \code
+ * Ensemble ensemble;
+ * ensemble.generate([&](EdgeSink &sink) { randomWattsStrogatzGraph(sink, 1000, 10, p); },
+ *     seed, 10000, [&](int i, int n, const Ensemble::Edges &edges) { ... });
+ * \endcode
+ */
+class Ensemble {
+public:
+	//! A generator with bound parameters.
+	using Model = std::function<void(EdgeSink &)>;
+
+	using Edges = std::vector<std::pair<uint32_t, uint32_t>>;
+
+	//! Receives sample \a i with \a n nodes; is called concurrently from the workers.
+	using Callback = std::function<void(int i, int n, const Edges &edges)>;
+
+	//! Scratch storage owned by a worker and reused for all its samples.
+	struct Worker {
+		Edges edges;
+		ScratchArena arena;
+	};
+
+private:
+	std::vector<std::thread> m_threads;
+	std::unique_ptr<Worker[]> m_workers;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_idle;
+	std::function<void(Worker &)> m_job;
+	uint64_t m_generation = 0;
+	int m_busy = 0;
+	bool m_stop = false;
+	std::exception_ptr m_error;
+
+	void work(int w) {
+		uint64_t generation = 0;
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [&] { return m_stop || m_generation != generation; });
+				if (m_stop) return;
+				generation = m_generation;
+			}
+
+			try {
+				m_job(m_workers[w]);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (!m_error) m_error = std::current_exception();
+			}
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_busy == 0) {
+				m_idle.notify_all();
+			}
+		}
+	}
+
+	//! Runs \p job on every worker and waits until all of them have returned.
+	void run(const std::function<void(Worker &)> &job) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_job = job;
+		m_error = nullptr;
+		m_busy = (int)m_threads.size();
+		m_generation++;
+		m_wake.notify_all();
+		m_idle.wait(lock, [this] { return m_busy == 0; });
+
+		if (m_error) {
+			std::rethrow_exception(m_error);
+		}
+	}
+
+	//! Runs \p sample(worker, i) for i = 0, ..., count-1, distributing the indices dynamically.
+	void forEachSample(int count, const std::function<void(Worker &, int)> &sample) {
+		std::atomic<int> next(0);
+		run([&](Worker &worker) {
+			for (int i = next++; i < count; i = next++) {
+				try {
+					ArenaScope scope(worker.arena);
+					// the workers already use all cores
+					ThreadLimit limit(1);
+					sample(worker, i);
+				} catch (...) {
+					next = count;
+					throw;
+				}
+			}
+		});
+	}
+
+public:
+	//! Starts \p numberOfThreads workers, one per hardware thread if 0.
+	explicit Ensemble(int numberOfThreads = 0) {
+		if (numberOfThreads <= 0) {
+			numberOfThreads = (int)std::max(1u, std::thread::hardware_concurrency());
+		}
+		m_workers.reset(new Worker[numberOfThreads]);
+		for (int w = 0; w < numberOfThreads; w++) {
+			m_threads.emplace_back(&Ensemble::work, this, w);
+		}
+	}
+
+	Ensemble(const Ensemble &) = delete;
+	Ensemble &operator=(const Ensemble &) = delete;
+
+	~Ensemble() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+			m_wake.notify_all();
+		}
+		for (std::thread &thread : m_threads) {
+			thread.join();
+		}
+	}
+
+	//! Returns the number of workers.
+	int numberOfThreads() const { return (int)m_threads.size(); }
+
+	//! Generates sample \p i of the ensemble of \p model with base seed \p seed into \p sink on the calling thread.
+	static void generateSample(const Model &model, uint64_t seed, int i, EdgeSink &sink) {
+		SeedScope scope(seed, (uint64_t)i);
+		model(sink);
+	}
+
+	//! Generates \p count samples of \p model and hands each to \p callback.
+	/**
+	 * The edges passed to \p callback are only valid during the call. If a
+	 * generator or the callback throws, the remaining samples are skipped and
+	 * the exception is rethrown.
+	 */
+	void generate(const Model &model, uint64_t seed, int count, const Callback &callback) {
+		forEachSample(count, [&](Worker &worker, int i) {
+			worker.edges.clear();
+			EdgeListSink sink(worker.edges);
+			generateSample(model, seed, i, sink);
+			callback(i, sink.numberOfNodes(), worker.edges);
+		});
+	}
+
+	//! Generates \p count samples of \p model into the preallocated \p graphs[0], ..., \p graphs[count-1].
+	void generate(const Model &model, uint64_t seed, int count, std::vector<Graph> &graphs) {
+		OGDF_ASSERT((int)graphs.size() >= count);
+		forEachSample(count, [&](Worker &, int i) {
+			graphs[i].clear();
+			GraphSink sink(graphs[i]);
+			generateSample(model, seed, i, sink);
+		});
+	}
+};
+
+}
@@ -0,0 +1,162 @@
+/** \file
+ * \brief Declaration of GeneratorStats, counters and phase timers of the generators.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace ogdf {
+
+//! Work done by the generators on one thread.
+/**
+ * The generators only record statistics if OGDF_GENERATORS_STATS is
+ * defined; otherwise GeneratorProbe is empty and the instrumentation is
+ * compiled away, so generatorStats() stays zero.
+ *
+ * \code
+ * generatorStats().reset();
+ * randomRegularGraph(sink, n, 3);
+ * std::clog << generatorStats() << std::endl;
+ * \endcode
+ */
+struct GeneratorStats {
+	//! Phases of a generator call.
+	enum class Phase {
+		Setup,  //!< adding nodes, drawing weights and coordinates, preprocessing them
+		Edges,  //!< examining pairs and emitting the chosen edges to the sink
+		Finish  //!< EdgeSink::finish(), e.g. building the Graph of a GraphSink
+	};
+	static constexpr int numberOfPhases = 3;
+
+	//! Wall time spent in each phase, in seconds.
+	double seconds[numberOfPhases] = {0.0, 0.0, 0.0};
+
+	//! Number of generator calls.
+	uint64_t calls = 0;
+	//! Random numbers drawn from RandomEngine objects.
+	uint64_t randomDraws = 0;
+	//! Proposals that were drawn and then discarded, e.g. an attachment that failed its coin flip.
+	uint64_t rejections = 0;
+	//! Attempts started over from scratch, e.g. non-simple pairings of randomRegularGraph().
+	uint64_t restarts = 0;
+	//! Pairs whose edge was decided individually; skipped pairs are not counted.
+	uint64_t pairsExamined = 0;
+	//! Edges passed to the sink.
+	uint64_t edgesEmitted = 0;
+
+	//! Returns the time spent in \p phase.
+	double time(Phase phase) const { return seconds[static_cast<int>(phase)]; }
+
+	//! Sets all counters and timers to zero.
+	void reset() { *this = GeneratorStats(); }
+
+	//! Adds the counters and timers of \p other.
+	GeneratorStats &operator+=(const GeneratorStats &other) {
+		for (int i = 0; i < numberOfPhases; i++) {
+			seconds[i] += other.seconds[i];
+		}
+		calls += other.calls;
+		randomDraws += other.randomDraws;
+		rejections += other.rejections;
+		restarts += other.restarts;
+		pairsExamined += other.pairsExamined;
+		edgesEmitted += other.edgesEmitted;
+		return *this;
+	}
+};
+
+//! Writes \p stats as a single line of key=value pairs, e.g. for logs.
+inline std::ostream &operator<<(std::ostream &os, const GeneratorStats &stats) {
+	return os << "calls=" << stats.calls
+		<< " setupSeconds=" << stats.time(GeneratorStats::Phase::Setup)
+		<< " edgesSeconds=" << stats.time(GeneratorStats::Phase::Edges)
+		<< " finishSeconds=" << stats.time(GeneratorStats::Phase::Finish)
+		<< " randomDraws=" << stats.randomDraws
+		<< " rejections=" << stats.rejections
+		<< " restarts=" << stats.restarts
+		<< " pairsExamined=" << stats.pairsExamined
+		<< " edgesEmitted=" << stats.edgesEmitted;
+}
+
+//! Returns the statistics collected on the calling thread.
+inline GeneratorStats &generatorStats() {
+	static thread_local GeneratorStats stats;
+	return stats;
+}
+
+#ifdef OGDF_GENERATORS_STATS
+
+//! Records the statistics of a single generator call in generatorStats().
+/**
+ * Counters are kept in the probe and added to generatorStats() on
+ * destruction, so the hot loops do not touch thread-local storage. The
+ * probe starts in the setup phase; only the outermost probe of a thread
+ * measures time, so a generator calling another one is not timed twice.
+ */
+class GeneratorProbe {
+	using Clock = std::chrono::steady_clock;
+
+	GeneratorStats m_stats;
+	Clock::time_point m_start;
+	int m_phase = 0;
+	bool m_timed;
+
+	static int &depth() {
+		static thread_local int depth = 0;
+		return depth;
+	}
+
+	void stopClock() {
+		if (m_timed) {
+			Clock::time_point now = Clock::now();
+			m_stats.seconds[m_phase] += std::chrono::duration<double>(now - m_start).count();
+			m_start = now;
+		}
+	}
+
+public:
+	GeneratorProbe() : m_timed(depth()++ == 0) {
+		m_stats.calls = 1;
+		if (m_timed) {
+			m_start = Clock::now();
+		}
+	}
+
+	GeneratorProbe(const GeneratorProbe &) = delete;
+	GeneratorProbe &operator=(const GeneratorProbe &) = delete;
+
+	~GeneratorProbe() {
+		stopClock();
+		depth()--;
+		generatorStats() += m_stats;
+	}
+
+	//! Ends the current phase and starts \p phase.
+	void phase(GeneratorStats::Phase phase) {
+		stopClock();
+		m_phase = static_cast<int>(phase);
+	}
+
+	void rejections(uint64_t count = 1) { m_stats.rejections += count; }
+	void restarts(uint64_t count = 1) { m_stats.restarts += count; }
+	void pairs(uint64_t count = 1) { m_stats.pairsExamined += count; }
+	void edges(uint64_t count = 1) { m_stats.edgesEmitted += count; }
+};
+
+#else
+
+class GeneratorProbe {
+public:
+	void phase(GeneratorStats::Phase) { }
+	void rejections(uint64_t = 1) { }
+	void restarts(uint64_t = 1) { }
+	void pairs(uint64_t = 1) { }
+	void edges(uint64_t = 1) { }
+};
+
+#endif
+
+}
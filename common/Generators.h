@@ -0,0 +1,158 @@
+/** \file
+ * \brief Declarations of the random graph generators.
+ *
+ * Every generator writes into an EdgeSink; the overloads taking an
+ * ogdf::Graph clear it and build the graph with a GraphSink. See the
+ * source file of each model for references and details. Like their
+ * definitions, the generators live in the global namespace.
+ */
+
+#pragma once
+
+#include <string>
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/EdgeArray.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include "Checkpoint.h"
+#include "EdgeSink.h"
+#include "SpaceFillingCurve.h"
+
+//! \name Chung-Lu
+//! @{
+
+void randomChungLuGraph(ogdf::EdgeSink &sink, const ogdf::Array<int> &weights);
+void randomChungLuGraph(ogdf::Graph &G, ogdf::Array<int> &weights);
+void randomChungLuRandomWeightsGraph(ogdf::EdgeSink &sink, int n);
+void randomChungLuRandomWeightsGraph(ogdf::Graph &G, int n);
+
+//! @}
+//! \name Norros-Reittu
+//! @{
+
+void norrosReittuGraph(ogdf::EdgeSink &sink, const ogdf::Array<int> &weights);
+void norrosReittuGraph(ogdf::Graph &G, ogdf::Array<int> &weights);
+void norrosReittuRandomWeightsGraph(ogdf::EdgeSink &sink, int n);
+void norrosReittuRandomWeightsGraph(ogdf::Graph &G, int n);
+
+//! @}
+//! \name Preferential attachment
+//! @{
+
+void preferentialAttachmentGraph(ogdf::EdgeSink &sink, int n, int d);
+void preferentialAttachmentGraph(ogdf::Graph &G, int n, int d);
+void preferentialAttachmentGraph(ogdf::EdgeSink &sink, int n, int d, ogdf::Checkpoint &checkpoint);
+void randomBipartitePrefrentialGraph(ogdf::EdgeSink &sink, int n, int d);
+void randomBipartitePrefrentialGraph(ogdf::Graph &G, int n, int d);
+void randomBipartitePrefrentialGraph(ogdf::EdgeSink &sink, int n, int d, ogdf::Checkpoint &checkpoint);
+
+//! @}
+//! \name Small world and regular graphs
+//! @{
+
+void randomWattsStrogatzGraph(ogdf::EdgeSink &sink, int n, int k, double probability);
+void randomWattsStrogatzGraph(ogdf::Graph &G, int n, int k, double probability);
+void randomRegularGraph(ogdf::EdgeSink &sink, int n, int k);
+void randomRegularGraph(ogdf::Graph &G, int n, int k);
+
+//! @}
+//! \name Geometric models
+//! @{
+
+void randomGeographicalThresholdGraph(ogdf::EdgeSink &sink, int n, double alpha, double theta, double lambda = 1.0, int dimension = 2, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomGeographicalThresholdGraph(ogdf::Graph &G, int n, double alpha, double theta, double lambda = 1.0, int dimension = 2, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomGeographicalThresholdGraph(ogdf::Graph &G, ogdf::GraphAttributes &GA, ogdf::EdgeArray<double> &distance, int n, double alpha, double theta, double lambda = 1.0, int dimension = 2, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomGeographicalThresholdWeightsGraph(ogdf::EdgeSink &sink, const ogdf::Array<int> &weights, double alpha, double theta, double lambda = 1.0, int dimension = 2);
+void randomGeographicalThresholdWeightsGraph(ogdf::Graph &G, ogdf::Array<int> &weights, double alpha, double theta, double lambda = 1.0, int dimension = 2);
+void randomGeographicalThresholdWeightsGraph(ogdf::Graph &G, ogdf::GraphAttributes &GA, ogdf::EdgeArray<double> &distance, ogdf::Array<int> &weights, double alpha, double theta, double lambda = 1.0, int dimension = 2);
+
+void randomGeometricCubeGraph(ogdf::EdgeSink &sink, int n, double threshold, int dimension = 2, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomGeometricCubeGraph(ogdf::Graph &G, int n, double threshold, int dimension = 2, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomGeometricCubeGraph(ogdf::Graph &G, ogdf::GraphAttributes &GA, ogdf::EdgeArray<double> &distance, int n, double threshold, int dimension = 2, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomGeometricTorusGraph(ogdf::EdgeSink &sink, int n, double threshold);
+void randomGeometricTorusGraph(ogdf::Graph &G, int n, double threshold);
+void randomGeometricTorusGraph(ogdf::Graph &G, ogdf::GraphAttributes &GA, ogdf::EdgeArray<double> &distance, int n, double threshold);
+
+//! @}
+//! \name Stochastic Kronecker and R-MAT
+//! @{
+
+void randomKroneckerGraph(ogdf::EdgeSink &sink, const ogdf::Array<double> &initiator, int scale, long long m, bool scramble = true, bool deduplicate = true);
+void randomKroneckerGraph(ogdf::Graph &G, const ogdf::Array<double> &initiator, int scale, long long m, bool scramble = true, bool deduplicate = true);
+void randomRMatGraph(ogdf::EdgeSink &sink, int scale, int edgeFactor = 16, double a = 0.57, double b = 0.19, double c = 0.19, double noise = 0.0, bool scramble = true, bool deduplicate = true);
+void randomRMatGraph(ogdf::Graph &G, int scale, int edgeFactor = 16, double a = 0.57, double b = 0.19, double c = 0.19, double noise = 0.0, bool scramble = true, bool deduplicate = true);
+
+//! @}
+//! \name Hyperbolic
+//! @{
+
+void randomHyperbolicGraph(ogdf::EdgeSink &sink, int n, double averageDegree, double exponent, double temperature = 0.0);
+void randomHyperbolicGraph(ogdf::Graph &G, int n, double averageDegree, double exponent, double temperature = 0.0);
+void randomHyperbolicGraphFast(ogdf::EdgeSink &sink, int n, double averageDegree, double exponent, double temperature = 0.0);
+void randomHyperbolicGraphFast(ogdf::Graph &G, int n, double averageDegree, double exponent, double temperature = 0.0);
+
+//! @}
+//! \name Waxman
+//! @{
+
+void randomWaxmanGraphUsingPlane(ogdf::EdgeSink &sink, int n, double alpha, double beta, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingPlane(ogdf::Graph &G, int n, double alpha, double beta, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingPlane(ogdf::Graph &G, ogdf::GraphAttributes &GA, ogdf::EdgeArray<double> &distance, int n, double alpha, double beta, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingPlaneFast(ogdf::EdgeSink &sink, int n, double alpha, double beta, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingPlaneFast(ogdf::Graph &G, int n, double alpha, double beta, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingPlaneFast(ogdf::Graph &G, ogdf::GraphAttributes &GA, ogdf::EdgeArray<double> &distance, int n, double alpha, double beta, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingGrid(ogdf::EdgeSink &sink, int n, double alpha, double beta, int width, int height, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingGrid(ogdf::Graph &G, int n, double alpha, double beta, int width, int height, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingGrid(ogdf::Graph &G, ogdf::GraphAttributes &GA, ogdf::EdgeArray<double> &distance, int n, double alpha, double beta, int width, int height, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingGridFast(ogdf::EdgeSink &sink, int n, double alpha, double beta, int width, int height, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingGridFast(ogdf::Graph &G, int n, double alpha, double beta, int width, int height, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraphUsingGridFast(ogdf::Graph &G, ogdf::GraphAttributes &GA, ogdf::EdgeArray<double> &distance, int n, double alpha, double beta, int width, int height, ogdf::NodeOrder order = ogdf::NodeOrder::Random);
+void randomWaxmanGraph(ogdf::EdgeSink &sink, int n, double alpha, double beta);
+void randomWaxmanGraph(ogdf::Graph &G, int n, double alpha, double beta);
+void randomWaxmanGraphIntegral(ogdf::EdgeSink &sink, int n, double alpha, double beta, int maxDistance);
+void randomWaxmanGraphIntegral(ogdf::Graph &G, int n, double alpha, double beta, int maxDistance);
+void randomWaxmanGraphFast(ogdf::EdgeSink &sink, int n, double alpha, double beta);
+void randomWaxmanGraphFast(ogdf::Graph &G, int n, double alpha, double beta);
+void randomWaxmanGraphFast(ogdf::Graph &G, ogdf::EdgeArray<double> &cost, int n, double alpha, double beta);
+void randomWaxmanGraphIntegralFast(ogdf::EdgeSink &sink, int n, double alpha, double beta, int maxDistance);
+void randomWaxmanGraphIntegralFast(ogdf::Graph &G, int n, double alpha, double beta, int maxDistance);
+void randomWaxmanGraphIntegralFast(ogdf::Graph &G, ogdf::EdgeArray<int> &cost, int n, double alpha, double beta, int maxDistance);
+
+//! @}
+//! \name Shards
+//! @{
+
+//! Returns true if the generator called \p name supports shards, see generateShard() in Shard.h.
+/**
+ * These are the generators whose pair loop draws the decisions for the pairs
+ * of every node from a random number block of its own and takes its rows
+ * from shardRows(). The Fast variants of the Waxman models do not, as they
+ * skip over pairs with one random number stream for all nodes. A generator
+ * added to this list has to take the rows of its pair loop from shardRows().
+ */
+inline bool supportsShards(const std::string &name) {
+	static const char *const names[] = {
+		"randomChungLuGraph",
+		"randomChungLuRandomWeightsGraph",
+		"norrosReittuGraph",
+		"norrosReittuRandomWeightsGraph",
+		"randomGeographicalThresholdGraph",
+		"randomGeographicalThresholdWeightsGraph",
+		"randomGeometricCubeGraph",
+		"randomGeometricTorusGraph",
+		"randomHyperbolicGraph",
+		"randomWaxmanGraphUsingPlane",
+		"randomWaxmanGraphUsingGrid",
+		"randomWaxmanGraph",
+		"randomWaxmanGraphIntegral",
+	};
+	for (const char *supported : names) {
+		if (name == supported) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//! @}
@@ -0,0 +1,153 @@
+/** \file
+ * \brief Declaration of the thread limit of the parallel generators, of
+ * parallelFor() and of parallelRadixSort().
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "GeneratorStats.h"
+
+namespace ogdf {
+
+//! Returns the thread limit installed on the calling thread by a ThreadLimit, or 0 if there is none.
+inline int &threadLimit() {
+	static thread_local int limit = 0;
+	return limit;
+}
+
+//! Returns the number of threads a parallel generator called on this thread may use.
+inline int generatorThreads() {
+	int limit = threadLimit();
+	return limit > 0 ? limit : (int)std::max(1u, std::thread::hardware_concurrency());
+}
+
+//! Limits the number of threads of the parallel generators called on this thread.
+/**
+ * Ensemble runs its samples with a limit of one thread, since its workers
+ * already use all cores. Limits can be nested; the previous limit is
+ * restored on destruction.
+ */
+class ThreadLimit {
+	int m_saved;
+
+public:
+	explicit ThreadLimit(int maxThreads) : m_saved(threadLimit()) {
+		threadLimit() = std::max(maxThreads, 1);
+	}
+
+	ThreadLimit(const ThreadLimit &) = delete;
+	ThreadLimit &operator=(const ThreadLimit &) = delete;
+
+	~ThreadLimit() {
+		threadLimit() = m_saved;
+	}
+};
+
+//! Returns the number of chunks parallelFor() splits \p count items with at least \p grain items per chunk into.
+inline int parallelChunks(size_t count, size_t grain) {
+	return (int)std::max<size_t>(1, std::min<size_t>((size_t)generatorThreads(), count / std::max<size_t>(grain, 1)));
+}
+
+//! Calls \p f(t, begin, end) for the \p chunks contiguous chunks [begin, end) of [0, \p count), each on a thread of its own.
+/**
+ * Chunk t is run on the calling thread if t = 0. The chunks only depend on
+ * \p count and \p chunks, so results collected per chunk can be combined
+ * in a deterministic order. If \p f throws, the first exception is rethrown
+ * after all threads have finished. The generatorStats() recorded by the
+ * other threads are added to those of the calling thread.
+ */
+template<typename F>
+void parallelFor(size_t count, int chunks, F f) {
+	std::vector<std::exception_ptr> errors(chunks);
+#ifdef OGDF_GENERATORS_STATS
+	std::vector<GeneratorStats> stats(chunks);
+#endif
+	auto run = [&](int t) {
+		try {
+			f(t, count * t / chunks, count * (t + 1) / chunks);
+		} catch (...) {
+			errors[t] = std::current_exception();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (int t = 1; t < chunks; t++) {
+		workers.emplace_back([&, t]() {
+#ifdef OGDF_GENERATORS_STATS
+			generatorStats().reset();
+			run(t);
+			stats[t] = generatorStats();
+#else
+			run(t);
+#endif
+		});
+	}
+	run(0);
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+#ifdef OGDF_GENERATORS_STATS
+	for (int t = 1; t < chunks; t++) {
+		generatorStats() += stats[t];
+	}
+#endif
+
+	for (const std::exception_ptr &error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+}
+
+//! Sorts \p keys, of which only the lowest \p keyBits bits may be set, by a parallel LSD radix sort.
+/**
+ * Every pass counts the digits of each chunk, computes where the keys of
+ * each digit and chunk go and moves them there, all chunks in parallel. The
+ * passes are stable, so the result does not depend on the number of chunks.
+ */
+inline void parallelRadixSort(std::vector<uint64_t> &keys, int keyBits) {
+	const int digitBits = 11;
+	const size_t buckets = (size_t)1 << digitBits;
+	const uint64_t mask = buckets - 1;
+
+	std::vector<uint64_t> buffer(keys.size());
+	int chunks = parallelChunks(keys.size(), 1 << 16);
+	std::vector<size_t> next(chunks * buckets);
+
+	for (int shift = 0; shift < keyBits; shift += digitBits) {
+		parallelFor(keys.size(), chunks, [&](int t, size_t begin, size_t end) {
+			size_t *count = next.data() + t * buckets;
+			std::fill(count, count + buckets, 0);
+			for (size_t i = begin; i < end; i++) {
+				count[(keys[i] >> shift) & mask]++;
+			}
+		});
+
+		// keys of digit d from chunk t follow those of smaller digits and of d from chunks 0, ..., t-1
+		size_t position = 0;
+		for (size_t d = 0; d < buckets; d++) {
+			for (int t = 0; t < chunks; t++) {
+				size_t count = next[t * buckets + d];
+				next[t * buckets + d] = position;
+				position += count;
+			}
+		}
+
+		parallelFor(keys.size(), chunks, [&](int t, size_t begin, size_t end) {
+			size_t *position = next.data() + t * buckets;
+			for (size_t i = begin; i < end; i++) {
+				buffer[position[(keys[i] >> shift) & mask]++] = keys[i];
+			}
+		});
+		keys.swap(buffer);
+	}
+}
+
+}
@@ -0,0 +1,228 @@
+/** \file
+ * \brief Declaration of RandomEngine and CounterStream, the random number engines of
+ * the generators, and of the seeds the generators draw for them.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include <ogdf/basic/basic.h>
+
+#include "GeneratorStats.h"
+
+namespace ogdf {
+
+//! Returns the SplitMix64 hash of \p x, which maps consecutive values to well-distributed seeds.
+inline uint64_t splitMix64(uint64_t x) {
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+//! Seeds drawn by generators on the calling thread while a SeedScope is active.
+struct SeedState {
+	bool active = false;
+	uint64_t seed = 0;
+	uint64_t stream = 0;
+	uint64_t counter = 0;
+};
+
+inline SeedState &seedState() {
+	static thread_local SeedState state;
+	return state;
+}
+
+//! Returns the seed for the next random engine of a generator.
+/**
+ * Inside a SeedScope, the seeds only depend on the seed and stream of the
+ * scope and the number of seeds drawn before; otherwise they are drawn
+ * from OGDF's global random number generator, see ogdf::setSeed().
+ */
+inline uint64_t generatorSeed() {
+	SeedState &state = seedState();
+	if (!state.active) {
+		return randomSeed();
+	}
+	uint64_t key = splitMix64(state.seed) ^ splitMix64(state.stream * 0x632be59bd9b4e019ULL + state.counter++);
+	return splitMix64(key);
+}
+
+//! Makes the generators called on this thread draw their seeds from (\p seed, \p stream).
+/**
+ * Two runs of a generator inside scopes with the same seed and stream
+ * produce the same graph, independent of the thread and of what other
+ * threads do. Scopes can be nested; the previous state is restored on
+ * destruction.
+ *
+ * \code
+ * SeedScope scope(seed);
+ * randomRegularGraph(sink, n, 3);   // the same graph for every run with this seed
+ * \endcode
+ */
+class SeedScope {
+	SeedState m_saved;
+
+public:
+	explicit SeedScope(uint64_t seed, uint64_t stream = 0) : m_saved(seedState()) {
+		SeedState &state = seedState();
+		state.active = true;
+		state.seed = seed;
+		state.stream = stream;
+		state.counter = 0;
+	}
+
+	SeedScope(const SeedScope &) = delete;
+	SeedScope &operator=(const SeedScope &) = delete;
+
+	~SeedScope() {
+		seedState() = m_saved;
+	}
+};
+
+//! Replaces \p counter by its Philox4x32-10 block under the key (\p key0, \p key1).
+/**
+ * See J. K. Salmon et al., Parallel random numbers: as easy as 1, 2, 3,
+ * SC 2011. The block is a bijective function of the counter, so distinct
+ * counters give independent random numbers.
+ */
+inline void philox4x32(uint32_t counter[4], uint32_t key0, uint32_t key1) {
+	for (int round = 0; round < 10; round++) {
+		uint64_t product0 = (uint64_t)0xd2511f53u * counter[0];
+		uint64_t product1 = (uint64_t)0xcd9e8d57u * counter[2];
+		uint32_t next[4] = {
+			(uint32_t)(product1 >> 32) ^ counter[1] ^ key0, (uint32_t)product1,
+			(uint32_t)(product0 >> 32) ^ counter[3] ^ key1, (uint32_t)product0};
+		std::memcpy(counter, next, sizeof(next));
+		key0 += 0x9e3779b9u;
+		key1 += 0xbb67ae85u;
+	}
+}
+
+//! Counter-based random numbers, indexed by a seed, a stream and a block.
+/**
+ * The numbers of block \a b in stream \a s are the Philox4x32-10 blocks of
+ * the counters (0, b, s), (1, b, s), ... under the key \a seed. A generator
+ * that draws the numbers of each part of its output, e.g. of every node,
+ * from a block of its own can regenerate any part on its own, in any order
+ * and on any thread; the parallel and sharded generators rely on this. A
+ * block holds 2^33 numbers.
+ *
+ * CounterStream is a UniformRandomBitGenerator, so it can be used with the
+ * distributions of \<random\>.
+ */
+class CounterStream {
+	uint32_t m_key[2];
+	uint32_t m_counter[4];
+	uint32_t m_output[4];
+	int m_next = 4;
+
+public:
+	using result_type = uint64_t;
+
+	CounterStream(uint64_t seed, uint64_t stream, uint64_t block)
+		: m_key{(uint32_t)seed, (uint32_t)(seed >> 32)},
+		  m_counter{0, (uint32_t)block, (uint32_t)(block >> 32), (uint32_t)stream} {
+		OGDF_ASSERT(stream <= 0xffffffffu);
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return ~(result_type)0; }
+
+	//! Continues with number \p index of block \p block.
+	void seek(uint64_t block, uint64_t index = 0) {
+		m_counter[0] = (uint32_t)(index / 2);
+		m_counter[1] = (uint32_t)block;
+		m_counter[2] = (uint32_t)(block >> 32);
+		m_next = 4;
+		if (index % 2 == 1) {
+			(*this)();
+		}
+	}
+
+	result_type operator()() {
+		if (m_next == 4) {
+			std::memcpy(m_output, m_counter, sizeof(m_output));
+			philox4x32(m_output, m_key[0], m_key[1]);
+			m_counter[0]++;
+			m_next = 0;
+		}
+#ifdef OGDF_GENERATORS_STATS
+		generatorStats().randomDraws++;
+#endif
+		uint64_t result = ((uint64_t)m_output[m_next] << 32) | m_output[m_next + 1];
+		m_next += 2;
+		return result;
+	}
+
+	//! Returns a uniform double in [0, 1).
+	double uniform() {
+		return (double)((*this)() >> 11) * 0x1.0p-53;
+	}
+};
+
+//! The sequential random number engine of the generators, xoshiro256** (Blackman and Vigna, 2018).
+/**
+ * Its 256-bit state is filled from the 64-bit seed by SplitMix64, so
+ * distinct seeds, e.g. those drawn for the samples of an Ensemble, give
+ * distinct streams; a 31-bit engine like std::minstd_rand would map
+ * distinct seeds to the same stream by the birthday bound. It counts its
+ * draws in generatorStats() if OGDF_GENERATORS_STATS is defined.
+ */
+class RandomEngine {
+	uint64_t m_state[4];
+
+	static uint64_t rotl(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+public:
+	using result_type = uint64_t;
+
+	//! Number of 64-bit words of the state.
+	static constexpr int stateSize = 4;
+
+	explicit RandomEngine(result_type seed = 0) {
+		this->seed(seed);
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return ~(result_type)0; }
+
+	result_type operator()() {
+#ifdef OGDF_GENERATORS_STATS
+		generatorStats().randomDraws++;
+#endif
+		uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+		uint64_t t = m_state[1] << 17;
+		m_state[2] ^= m_state[0];
+		m_state[3] ^= m_state[1];
+		m_state[1] ^= m_state[2];
+		m_state[0] ^= m_state[3];
+		m_state[2] ^= t;
+		m_state[3] = rotl(m_state[3], 45);
+		return result;
+	}
+
+	//! Restarts the engine with the stream of \p seed.
+	void seed(result_type seed) {
+		// consecutive SplitMix64 outputs, which are never all zero
+		for (int i = 0; i < stateSize; i++) {
+			m_state[i] = splitMix64(seed + i * 0x9e3779b97f4a7c15ULL);
+		}
+	}
+
+	//! Returns word \p i of the state, from which setState() continues the same sequence.
+	uint64_t state(int i) const { return m_state[i]; }
+
+	//! Continues the sequence of the engine whose state words were \p state[0], ..., \p state[stateSize - 1].
+	void setState(const uint64_t *state) {
+		for (int i = 0; i < stateSize; i++) {
+			m_state[i] = state[i];
+		}
+	}
+};
+}
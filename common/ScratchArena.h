@@ -0,0 +1,214 @@
+/** \file
+ * \brief Declaration of ScratchArena, monotonic scratch memory for the temporaries of generators.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace ogdf {
+
+//! Bump allocator for the temporary arrays of generators.
+/**
+ * Memory is handed out from large blocks and only released as a whole by
+ * rewinding to an earlier position. When an arena is rewound completely
+ * after it had to grow by more than one block, its blocks are merged into
+ * one, so a repeated workload runs without any heap allocation after the
+ * first run.
+ *
+ * Generators do not take an arena as a parameter; they allocate through a
+ * ScratchFrame, which uses the arena installed on the calling thread by an
+ * ArenaScope and a private arena otherwise.
+ *
+ * All temporaries of randomGeometricCubeGraph(), randomGeometricTorusGraph(),
+ * randomGeographicalThresholdGraph(), randomGeographicalThresholdWeightsGraph(),
+ * randomBipartitePrefrentialGraph() and randomRegularGraph() come from the
+ * arena, so repeated calls of these only allocate in the sink. The node
+ * orders of NodeOrder::Morton and NodeOrder::Hilbert, the points of the
+ * Waxman models and the other generators still use the heap.
+ *
+ * \code
+ * ScratchArena arena;
+ * ArenaScope scope(arena);
+ * CountingSink sink;
+ * for (int i = 0; i < samples; i++) {
+ *     randomGeometricCubeGraph(sink, n, threshold);   // no heap allocation for i > 0
+ * }
+ * \endcode
+ */
+class ScratchArena {
+	static constexpr size_t s_alignment = 64;
+	static constexpr size_t s_minimumBlock = 1 << 16;
+
+	struct Block {
+		char *data;
+		size_t size;
+	};
+
+	std::vector<Block> m_blocks;
+	size_t m_block = 0;
+	size_t m_offset = 0;
+	size_t m_heapAllocations = 0;
+
+	void addBlock(size_t size) {
+		size = (size + s_alignment - 1) / s_alignment * s_alignment;
+		char *data = static_cast<char *>(::operator new(size, std::align_val_t(s_alignment)));
+		m_blocks.push_back(Block{data, size});
+		m_heapAllocations++;
+	}
+
+	void release() {
+		for (const Block &block : m_blocks) {
+			::operator delete(block.data, std::align_val_t(s_alignment));
+		}
+		m_blocks.clear();
+	}
+
+public:
+	//! Position of an arena, see position() and rewind().
+	struct Position {
+		size_t block;
+		size_t offset;
+	};
+
+	//! Creates an arena whose first block has \p initialSize bytes; no memory is allocated if 0.
+	explicit ScratchArena(size_t initialSize = 0) {
+		if (initialSize > 0) {
+			addBlock(initialSize);
+		}
+	}
+
+	ScratchArena(const ScratchArena &) = delete;
+	ScratchArena &operator=(const ScratchArena &) = delete;
+
+	~ScratchArena() {
+		release();
+	}
+
+	//! Returns uninitialized memory for \p count objects of the trivial type \p T, aligned to 64 bytes.
+	template<typename T>
+	T *allocate(size_t count) {
+		static_assert(std::is_trivially_destructible<T>::value, "scratch objects are never destroyed");
+		size_t bytes = std::max<size_t>(count * sizeof(T), 1);
+		bytes = (bytes + s_alignment - 1) / s_alignment * s_alignment;
+
+		while (m_block < m_blocks.size() && m_offset + bytes > m_blocks[m_block].size) {
+			m_block++;
+			m_offset = 0;
+		}
+		if (m_block == m_blocks.size()) {
+			size_t previous = m_blocks.empty() ? 0 : m_blocks.back().size;
+			addBlock(std::max({bytes, 2 * previous, s_minimumBlock}));
+			m_offset = 0;
+		}
+
+		T *result = reinterpret_cast<T *>(m_blocks[m_block].data + m_offset);
+		m_offset += bytes;
+		return result;
+	}
+
+	//! Returns the current position, to which the arena can be rewound later.
+	Position position() const { return Position{m_block, m_offset}; }
+
+	//! Releases everything allocated since \p mark was taken.
+	void rewind(Position mark) {
+		m_block = mark.block;
+		m_offset = mark.offset;
+
+		if (m_block == 0 && m_offset == 0 && m_blocks.size() > 1) {
+			size_t total = 0;
+			for (const Block &block : m_blocks) {
+				total += block.size;
+			}
+			release();
+			addBlock(total);
+		}
+	}
+
+	//! Releases everything.
+	void reset() { rewind(Position{0, 0}); }
+
+	//! Returns the number of bytes reserved from the heap.
+	size_t capacity() const {
+		size_t total = 0;
+		for (const Block &block : m_blocks) {
+			total += block.size;
+		}
+		return total;
+	}
+
+	//! Returns the number of heap allocations performed so far.
+	size_t numberOfHeapAllocations() const { return m_heapAllocations; }
+
+	//! Returns the arena installed on the calling thread by an ArenaScope, or nullptr.
+	static ScratchArena *&current() {
+		static thread_local ScratchArena *arena = nullptr;
+		return arena;
+	}
+};
+
+
+//! Installs \a arena as the scratch arena of the generators called on this thread.
+/**
+ * Scopes can be nested; the previous arena is restored on destruction.
+ */
+class ArenaScope {
+	ScratchArena *m_saved;
+
+public:
+	explicit ArenaScope(ScratchArena &arena) : m_saved(ScratchArena::current()) {
+		ScratchArena::current() = &arena;
+	}
+
+	ArenaScope(const ArenaScope &) = delete;
+	ArenaScope &operator=(const ArenaScope &) = delete;
+
+	~ArenaScope() {
+		ScratchArena::current() = m_saved;
+	}
+};
+
+
+//! Allocations of a single generator call, released when the frame is destroyed.
+/**
+ * Uses the arena of the current ArenaScope, or a private arena that lives
+ * as long as the frame if there is none.
+ */
+class ScratchFrame {
+	ScratchArena m_local;
+	ScratchArena &m_arena;
+	ScratchArena::Position m_mark;
+
+public:
+	ScratchFrame()
+		: m_arena(ScratchArena::current() != nullptr ? *ScratchArena::current() : m_local),
+		  m_mark(m_arena.position()) { }
+
+	ScratchFrame(const ScratchFrame &) = delete;
+	ScratchFrame &operator=(const ScratchFrame &) = delete;
+
+	~ScratchFrame() {
+		m_arena.rewind(m_mark);
+	}
+
+	//! Returns uninitialized memory for \p count objects of type \p T.
+	template<typename T>
+	T *allocate(size_t count) {
+		return m_arena.allocate<T>(count);
+	}
+
+	//! Returns memory for \p count objects of type \p T, each initialized to \p value.
+	template<typename T>
+	T *allocate(size_t count, const T &value) {
+		T *result = m_arena.allocate<T>(count);
+		std::fill(result, result + count, value);
+		return result;
+	}
+};
+
+}
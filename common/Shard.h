@@ -0,0 +1,122 @@
+/** \file
+ * \brief Declaration of ShardScope and generateShard(), which split the
+ * edges of a generator into shards that can be produced independently.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "EdgeSink.h"
+#include "Generators.h"
+#include "Random.h"
+
+namespace ogdf {
+
+//! The shard of the edges that generators called on the calling thread produce.
+struct ShardState {
+	bool active = false;
+	int index = 0;
+	int count = 1;
+};
+
+inline ShardState &shardState() {
+	static thread_local ShardState state;
+	return state;
+}
+
+//! Returns the first row of shard \p index of \p count of a pair loop over \p n nodes.
+/**
+ * Row v holds the pairs {v, w}, w > v, so the shards consist of consecutive
+ * rows with about the same number of pairs rather than of nodes.
+ */
+inline int shardBoundary(int n, int index, int count) {
+	if (index <= 0) return 0;
+	if (index >= count) return n;
+
+	// the rows 0, ..., v-1 hold v (2n - v - 1) / 2 pairs
+	auto pairsBefore = [n](long long v) { return v * (2LL * n - v - 1) / 2; };
+	long long target = (long long)std::ceil((double)pairsBefore(n) * index / count);
+	int lower = 0, upper = n;
+	while (lower < upper) {
+		int middle = lower + (upper - lower) / 2;
+		if (pairsBefore(middle) < target) {
+			lower = middle + 1;
+		} else {
+			upper = middle;
+		}
+	}
+	return lower;
+}
+
+//! Returns the rows [first, second) of a pair loop over \p n nodes that belong to the current shard.
+/**
+ * Outside a ShardScope, these are all rows.
+ */
+inline std::pair<int, int> shardRows(int n) {
+	ShardState &state = shardState();
+	if (!state.active) {
+		return {0, n};
+	}
+	return {shardBoundary(n, state.index, state.count), shardBoundary(n, state.index + 1, state.count)};
+}
+
+//! Makes the generators called on this thread only produce shard \p index of \p count of their edges.
+/**
+ * Only generators that draw the decisions for the pairs of every node from a
+ * random number block of its own support shards; they still add all nodes
+ * and draw the points or weights of all of them, which takes linear time.
+ * Scopes can be nested; the previous state is restored on destruction.
+ */
+class ShardScope {
+	ShardState m_saved;
+
+public:
+	ShardScope(int index, int count) : m_saved(shardState()) {
+		OGDF_ASSERT(0 <= index && index < count);
+		ShardState &state = shardState();
+		state.active = true;
+		state.index = index;
+		state.count = count;
+	}
+
+	ShardScope(const ShardScope &) = delete;
+	ShardScope &operator=(const ShardScope &) = delete;
+
+	~ShardScope() {
+		shardState() = m_saved;
+	}
+};
+
+//! Writes shard \p shardIndex of \p shardCount of the graph that \p generate produces with \p seed into \p sink.
+/**
+ * The shards of the same seed are disjoint and their union is the graph
+ * generated inside SeedScope(\p seed) without shards, so each shard can be
+ * produced by a process of its own, e.g. into an EdgeListFileSink. Every
+ * shard contains all nodes.
+ *
+ * \p name is the generator that \p generate calls. Returns false, without
+ * running \p generate, if it does not support shards, see supportsShards()
+ * in Generators.h.
+ *
+ * \code
+ * EdgeListFileSink file("graph." + std::to_string(i) + ".edges", "ChungLu", "n=1000000", seed);
+ * generateShard(file, seed, i, shards, "randomChungLuRandomWeightsGraph",
+ *     [&](EdgeSink &sink) { randomChungLuRandomWeightsGraph(sink, 1000000); });
+ * \endcode
+ */
+inline bool generateShard(EdgeSink &sink, uint64_t seed, int shardIndex, int shardCount,
+		const std::string &name, const std::function<void(EdgeSink &)> &generate) {
+	if (!::supportsShards(name)) {
+		return false;
+	}
+	SeedScope seeds(seed);
+	ShardScope shard(shardIndex, shardCount);
+	generate(sink);
+	return true;
+}
+
+}
@@ -0,0 +1,141 @@
+/** \file
+ * \brief Declaration of NodeOrder and of the Morton and Hilbert orders that
+ * geometric generators can give their nodes.
+ *
+ * Numbering the nodes along a space-filling curve gives points that are
+ * close in space nearby indices, so the adjacency lists of the generated
+ * graph, and the points a generator looks up while searching its cells,
+ * stay close in memory.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Parallel.h"
+
+namespace ogdf {
+
+//! Order in which a geometric generator numbers the points it draws.
+enum class NodeOrder {
+	Random,  //!< in the order the points are drawn
+	Morton,  //!< along the Z-order curve, which interleaves the bits of the coordinates
+	Hilbert  //!< along the Hilbert curve, which unlike Morton never jumps between distant cells
+};
+
+//! Returns the position of the cell \p cell along the curve of \p order.
+/**
+ * The \p dimension coordinates of \p cell have \p bits bits each and are
+ * overwritten. Hilbert keys use Skilling's transposition ("Programming the
+ * Hilbert curve", 2004), which works in any dimension.
+ */
+inline uint64_t curveKey(uint32_t *cell, int dimension, int bits, NodeOrder order) {
+	if (order == NodeOrder::Hilbert && bits > 0) {
+		// undoing the excess work of the reflected Gray code
+		for (uint32_t q = 1u << (bits - 1); q > 1; q >>= 1) {
+			uint32_t p = q - 1;
+			for (int i = 0; i < dimension; i++) {
+				if (cell[i] & q) {
+					cell[0] ^= p;
+				} else {
+					uint32_t t = (cell[0] ^ cell[i]) & p;
+					cell[0] ^= t;
+					cell[i] ^= t;
+				}
+			}
+		}
+
+		// Gray encoding
+		for (int i = 1; i < dimension; i++) {
+			cell[i] ^= cell[i - 1];
+		}
+		uint32_t t = 0;
+		for (uint32_t q = 1u << (bits - 1); q > 1; q >>= 1) {
+			if (cell[dimension - 1] & q) {
+				t ^= q - 1;
+			}
+		}
+		for (int i = 0; i < dimension; i++) {
+			cell[i] ^= t;
+		}
+	}
+
+	// interleaving the bits, most significant first
+	uint64_t key = 0;
+	for (int b = bits - 1; b >= 0; b--) {
+		for (int i = 0; i < dimension; i++) {
+			key = (key << 1) | ((cell[i] >> b) & 1);
+		}
+	}
+	return key;
+}
+
+//! Returns the indices of the points 0, ..., \p n - 1 in the order \p order.
+/**
+ * \p coordinate(v, i) is coordinate i of point v. The bounding box of the
+ * points is divided into cells with as many bits per coordinate as fit
+ * into a 64-bit key next to the index of the point, at most 20; the
+ * points are sorted by the key of their cell, ties by index, with
+ * parallelRadixSort(). In very high dimensions only the first coordinates
+ * are used.
+ */
+template<typename Coordinate>
+std::vector<int> curveOrder(int n, int dimension, NodeOrder order, Coordinate coordinate) {
+	std::vector<int> result(n);
+	if (order == NodeOrder::Random || n < 2) {
+		for (int v = 0; v < n; v++) {
+			result[v] = v;
+		}
+		return result;
+	}
+
+	int indexBits = 1;
+	while (indexBits < 31 && (1 << indexBits) < n) {
+		indexBits++;
+	}
+	int used = std::min(dimension, 64 - indexBits);
+	int bits = std::min(20, (64 - indexBits) / used);
+
+	std::vector<double> lower(used), factor(used);
+	for (int i = 0; i < used; i++) {
+		double low = coordinate(0, i), high = low;
+		for (int v = 1; v < n; v++) {
+			low = std::min(low, coordinate(v, i));
+			high = std::max(high, coordinate(v, i));
+		}
+		lower[i] = low;
+		factor[i] = high > low ? (1 << bits) / (high - low) : 0.0;
+	}
+
+	std::vector<uint64_t> keys(n);
+	std::vector<uint32_t> cell(used);
+	const uint32_t last = (1u << bits) - 1;
+	for (int v = 0; v < n; v++) {
+		for (int i = 0; i < used; i++) {
+			cell[i] = std::min((uint32_t)((coordinate(v, i) - lower[i]) * factor[i]), last);
+		}
+		keys[v] = (curveKey(cell.data(), used, bits, order) << indexBits) | (uint64_t)v;
+	}
+
+	parallelRadixSort(keys, used * bits + indexBits);
+	const uint64_t mask = ((uint64_t)1 << indexBits) - 1;
+	for (int v = 0; v < n; v++) {
+		result[v] = (int)(keys[v] & mask);
+	}
+	return result;
+}
+
+//! Rearranges \p values, \p stride values per point, such that point v is the former point \p order[v].
+template<typename T>
+void applyCurveOrder(T *values, int stride, const std::vector<int> &order) {
+	std::vector<T> copy(values, values + order.size() * stride);
+	for (size_t v = 0; v < order.size(); v++) {
+		for (int i = 0; i < stride; i++) {
+			values[v * stride + i] = copy[(size_t)order[v] * stride + i];
+		}
+	}
+}
+
+}
@@ -0,0 +1,249 @@
+/** \file
+ * \brief Declaration of StatisticsSink, which summarizes the generated graph
+ * without storing its edges.
+ *
+ * Any generator runs in statistics-only mode by writing into a
+ * StatisticsSink instead of a GraphSink: every edge only increments the
+ * degree counters of its endpoints and a few accumulators, so a run needs
+ * four bytes per node and is not slowed down by building adjacency lists.
+ * This suits calibration sweeps, e.g. choosing the threshold of a
+ * geometric model for a target average degree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "EdgeSink.h"
+
+namespace ogdf {
+
+//! Edge sink that keeps degree counters and summary statistics instead of the edges.
+/**
+ * The degree of a node counts a loop twice, as in an ogdf::Graph.
+ *
+ * Triangles are counted only if a sample probability p > 0 is given: each
+ * edge that is not a loop is kept with probability p, decided by a hash of
+ * its endpoints, and triangles() returns the number of triangles among the
+ * kept edges divided by p^3, an unbiased estimate ("DOULION", Tsourakakis
+ * et al. 2009) that is exact for p = 1. This stores about p m edges, so it
+ * is only feasible where those fit into memory. Parallel edges are counted
+ * once.
+ *
+ * \code
+ * for (double threshold : {0.01, 0.02, 0.04}) {
+ *     StatisticsSink statistics;
+ *     randomGeometricTorusGraph(statistics, 20000, threshold);
+ *     double averageDegree = statistics.averageDegree();   // about pi * threshold^2 * n
+ * }
+ * \endcode
+ */
+class StatisticsSink : public EdgeSink {
+	std::vector<uint32_t> m_degree;
+	long long m_numberOfEdges;
+	long long m_numberOfLoops;
+	long long m_costCount;
+	double m_costSum;
+	double m_costMin;
+	double m_costMax;
+
+	double m_sampleProbability;
+	uint64_t m_sampleThreshold;
+	uint64_t m_sampleKey;
+	std::vector<std::pair<uint32_t, uint32_t>> m_sample;
+	double m_triangles;
+
+	//! Returns true if the edge {\p u, \p v}, \p u < \p v, belongs to the triangle sample.
+	bool sampled(uint32_t u, uint32_t v) const {
+		// splitmix64 finalizer of the endpoints
+		uint64_t x = (((uint64_t)u << 32) | v) ^ m_sampleKey;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		x ^= x >> 31;
+		return x <= m_sampleThreshold;
+	}
+
+	//! Counts the triangles among the sampled edges, which are normalized and sorted.
+	long long countSampledTriangles() const {
+		size_t n = m_degree.size();
+		std::vector<uint32_t> degree(n, 0);
+		for (const auto &e : m_sample) {
+			degree[e.first]++;
+			degree[e.second]++;
+		}
+
+		// orienting every edge towards the endpoint of larger degree, so every node has O(sqrt(m)) out-neighbors
+		auto before = [&](uint32_t u, uint32_t v) {
+			return degree[u] < degree[v] || (degree[u] == degree[v] && u < v);
+		};
+		std::vector<uint64_t> offset(n + 1, 0);
+		for (const auto &e : m_sample) {
+			offset[(before(e.first, e.second) ? e.first : e.second) + 1]++;
+		}
+		for (size_t v = 0; v < n; v++) {
+			offset[v + 1] += offset[v];
+		}
+		std::vector<uint32_t> out(m_sample.size());
+		std::vector<uint64_t> fill(offset.begin(), offset.end() - 1);
+		for (const auto &e : m_sample) {
+			bool forward = before(e.first, e.second);
+			out[fill[forward ? e.first : e.second]++] = forward ? e.second : e.first;
+		}
+
+		// every triangle is found once, from its first node along the orientation
+		long long triangles = 0;
+		std::vector<uint32_t> mark(n, 0);
+		for (size_t u = 0; u < n; u++) {
+			for (uint64_t i = offset[u]; i < offset[u + 1]; i++) {
+				mark[out[i]] = (uint32_t)u + 1;
+			}
+			for (uint64_t i = offset[u]; i < offset[u + 1]; i++) {
+				uint32_t w = out[i];
+				for (uint64_t j = offset[w]; j < offset[w + 1]; j++) {
+					if (mark[out[j]] == u + 1) {
+						triangles++;
+					}
+				}
+			}
+		}
+		return triangles;
+	}
+
+public:
+	//! Creates a sink that estimates the number of triangles from a sample of the edges with \p triangleSample probability.
+	/**
+	 * @param triangleSample is the probability p in [0, 1] with which an edge
+	 *        is kept for counting triangles; 0 disables counting.
+	 * @param sampleSeed selects the sampled edges.
+	 */
+	explicit StatisticsSink(double triangleSample = 0.0, uint64_t sampleSeed = 0)
+		: m_numberOfEdges(0), m_numberOfLoops(0), m_costCount(0), m_costSum(0.0),
+		  m_costMin(std::numeric_limits<double>::infinity()), m_costMax(-std::numeric_limits<double>::infinity()),
+		  m_sampleProbability(std::min(std::max(triangleSample, 0.0), 1.0)), m_sampleKey(sampleSeed), m_triangles(0.0)
+	{
+		double threshold = std::ldexp(m_sampleProbability, 64);
+		m_sampleThreshold = threshold >= 0x1p64 ? std::numeric_limits<uint64_t>::max() : (uint64_t)threshold;
+	}
+
+	void reserve(int n, long long /* m */) override {
+		m_degree.reserve(m_degree.size() + (size_t)n);
+	}
+
+	int addNode() override {
+		m_degree.push_back(0);
+		return (int)m_degree.size() - 1;
+	}
+
+	void addEdge(int u, int v) override {
+		m_numberOfEdges++;
+		m_degree[u]++;
+		m_degree[v]++;
+		if (u == v) {
+			m_numberOfLoops++;
+		} else if (m_sampleProbability > 0.0) {
+			uint32_t a = (uint32_t)std::min(u, v), b = (uint32_t)std::max(u, v);
+			if (sampled(a, b)) {
+				m_sample.emplace_back(a, b);
+			}
+		}
+	}
+
+	void addEdge(int u, int v, double cost) override {
+		addEdge(u, v);
+		m_costCount++;
+		m_costSum += cost;
+		m_costMin = std::min(m_costMin, cost);
+		m_costMax = std::max(m_costMax, cost);
+	}
+
+	//! Counts the triangles of the sample.
+	void finish() override {
+		if (m_sampleProbability > 0.0) {
+			std::sort(m_sample.begin(), m_sample.end());
+			m_sample.erase(std::unique(m_sample.begin(), m_sample.end()), m_sample.end());
+			double p = m_sampleProbability;
+			m_triangles = countSampledTriangles() / (p * p * p);
+			std::vector<std::pair<uint32_t, uint32_t>>().swap(m_sample);
+		}
+	}
+
+	//! Returns the number of nodes added.
+	int numberOfNodes() const { return (int)m_degree.size(); }
+
+	//! Returns the number of edges added, including loops and parallel edges.
+	long long numberOfEdges() const { return m_numberOfEdges; }
+
+	//! Returns the number of loops added.
+	long long numberOfLoops() const { return m_numberOfLoops; }
+
+	//! Returns the degree of node \p v.
+	uint32_t degree(int v) const { return m_degree[v]; }
+
+	//! Returns the degrees of all nodes.
+	const std::vector<uint32_t> &degrees() const { return m_degree; }
+
+	//! Returns the maximum degree, or 0 for the empty graph.
+	uint32_t maxDegree() const {
+		return m_degree.empty() ? 0 : *std::max_element(m_degree.begin(), m_degree.end());
+	}
+
+	//! Returns the average degree, or 0 for the empty graph.
+	double averageDegree() const {
+		return m_degree.empty() ? 0.0 : 2.0 * m_numberOfEdges / m_degree.size();
+	}
+
+	//! Returns the variance of the degrees.
+	double degreeVariance() const {
+		if (m_degree.empty()) return 0.0;
+		double mean = averageDegree(), sum = 0.0;
+		for (uint32_t d : m_degree) {
+			sum += (d - mean) * (d - mean);
+		}
+		return sum / m_degree.size();
+	}
+
+	//! Returns the number of nodes of each degree 0, ..., maxDegree().
+	std::vector<long long> degreeHistogram() const {
+		std::vector<long long> histogram((size_t)maxDegree() + 1, 0);
+		for (uint32_t d : m_degree) {
+			histogram[d]++;
+		}
+		return histogram;
+	}
+
+	//! Returns the number of nodes of degree 0.
+	long long isolatedNodes() const {
+		return std::count(m_degree.begin(), m_degree.end(), 0u);
+	}
+
+	//! Returns the number of edges added with a cost.
+	long long numberOfCosts() const { return m_costCount; }
+
+	//! Returns the average cost of the edges added with a cost, or 0 if there are none.
+	double averageCost() const { return m_costCount == 0 ? 0.0 : m_costSum / m_costCount; }
+
+	//! Returns the minimum cost of an edge, or infinity if there are none.
+	double minCost() const { return m_costMin; }
+
+	//! Returns the maximum cost of an edge, or -infinity if there are none.
+	double maxCost() const { return m_costMax; }
+
+	//! Returns the estimated number of triangles, or 0 if they are not counted; only valid after finish().
+	double triangles() const { return m_triangles; }
+
+	//! Returns the estimated global clustering coefficient, three times the triangles per path of length two.
+	double clustering() const {
+		double wedges = 0.0;
+		for (uint32_t d : m_degree) {
+			wedges += 0.5 * d * (d - 1.0);
+		}
+		return wedges > 0.0 ? 3.0 * m_triangles / wedges : 0.0;
+	}
+};
+
+}
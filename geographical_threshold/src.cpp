@@ -25,8 +25,13 @@
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/geometry.h>
 
-using std::minstd_rand;
-using std::default_random_engine;
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Random.h"
+#include "../common/ScratchArena.h"
+#include "../common/Shard.h"
+#include "../common/SpaceFillingCurve.h"
+
 using std::exponential_distribution;
 using std::uniform_int_distribution;
 using std::uniform_real_distribution;
@@ -34,124 +39,232 @@ using namespace ogdf;
 
 //! Creates a Geographical Threshold Graph. 
 /**
- * @param G is assigned the generated graph.
+ * @param sink is assigned the generated graph.
  * @param n is the number of nodes of the generated graph.
  * @param alpha is the model parameter.
  * @param theta is the threshold parameter.
  * @param lambda is the exponential distribution
  * @param dimension is the dimension of nodes to layed out.
+ * @param order is the order in which the points are numbered.
  */
-void randomGeographicalThresholdGraph(Graph &G, int n, double alpha, double theta, double lambda = 1.0, int dimension = 2) {
+void randomGeographicalThresholdGraph(EdgeSink &sink, int n, double alpha, double theta, double lambda, int dimension, NodeOrder order) {
 	OGDF_ASSERT(n >= 0);
 	OGDF_ASSERT(alpha > 0 && theta > 0 && lambda > 0);
 	
-	G.clear();
-	if (n == 0) return;
+	if (n == 0) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
 
 	// exponential generator for laying out points
-	default_random_engine generator;
+	RandomEngine generator(generatorSeed());
 	exponential_distribution<double> distribution(lambda);
 
 	// uniform generator for assigning weights
-	minstd_rand rng(randomSeed());
+	RandomEngine rng(generatorSeed());
 	uniform_real_distribution<> dist(0, 1);
 
-	NodeArray<Array<double>> cord(G, Array<double>(dimension));
-	NodeArray<double> weight(G, 0.0);
+	// coordinates of node i are cord[i*dimension] ... cord[i*dimension + dimension-1]
+	ScratchFrame scratch;
+	double *cord = scratch.allocate<double>((size_t)n * dimension);
+	double *weight = scratch.allocate<double>(n);
 
 	// adding n nodes to graph
+	sink.reserve(n, 0);
 	for (int i = 0; i < n; i++) {
-		G.newNode();
+		sink.addNode();
 	}
 
 	// setting random weights for nodes
-	for (node v : G.nodes) {
+	for (int v = 0; v < n; v++) {
 		weight[v] = dist(rng);
 	}
 
 	// using exponential distribution to generate random points
-	for (node v : G.nodes) {
+	for (int v = 0; v < n; v++) {
 		for (int i = 0; i < dimension; i++){
-			cord[v][i] = distribution(generator);
+			cord[v*dimension + i] = distribution(generator);
 		}
 	}
 
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
+	// numbering the points along a space-filling curve, together with their weights
+	if (order != NodeOrder::Random) {
+		std::vector<int> sorted = curveOrder(n, dimension, order, [&](int v, int i) { return cord[v*dimension + i]; });
+		applyCurveOrder(cord, dimension, sorted);
+		applyCurveOrder(weight, 1, sorted);
+	}
+
+	// reporting the positions of the nodes
+	for (int v = 0; v < n; v++) {
+		sink.setPosition(v, cord + (size_t)v * dimension, dimension);
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	for (int v = rows.first; v < rows.second; v++) {
+		probe.pairs(n - v - 1);
+		for (int w = v + 1; w < n; w++) {
 			double distance = 0.0;
 			for (int i = 0; i < dimension; i++) {
-				distance += (cord[v][i] - cord[w][i])*(cord[v][i] - cord[w][i]);
+				double delta = cord[v*dimension + i] - cord[w*dimension + i];
+				distance += delta*delta;
 			}
 			distance = sqrt(distance);
 
-			if ((weight(v) + weight(w)) > (theta*pow(distance, alpha))) {
-				G.newEdge(v, w);
+			if ((weight[v] + weight[w]) > (theta*pow(distance, alpha))) {
+				sink.addEdge(v, w, distance);
+				probe.edges();
 			}
 		}
 	}
 
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
 }
 
+//! Creates a Geographical Threshold Graph. 
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is the model parameter.
+ * @param theta is the threshold parameter.
+ * @param lambda is the exponential distribution
+ * @param dimension is the dimension of nodes to layed out.
+ * @param order is the order in which the points are numbered.
+ */
+void randomGeographicalThresholdGraph(Graph &G, int n, double alpha, double theta, double lambda, int dimension, NodeOrder order) {
+	G.clear();
+	GraphSink sink(G);
+	randomGeographicalThresholdGraph(sink, n, alpha, theta, lambda, dimension, order);
+}
 
-//! Creates a Geographical Threshold Graph with given weights. 
+//! Creates a Geographical Threshold Graph and assigns positions and edge lengths.
 /**
  * @param G is assigned the generated graph.
+ * @param GA is assigned the positions of the nodes, of which x, y and z are the first three coordinates; it must belong to \p G.
+ * @param distance is assigned the distance between the endpoints of each edge.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is the model parameter.
+ * @param theta is the threshold parameter.
+ * @param lambda is the exponential distribution
+ * @param dimension is the dimension of nodes to layed out.
+ * @param order is the order in which the points are numbered.
+ */
+void randomGeographicalThresholdGraph(Graph &G, GraphAttributes &GA, EdgeArray<double> &distance, int n, double alpha, double theta, double lambda, int dimension, NodeOrder order) {
+	G.clear();
+	GraphSink sink(G, &distance, &GA);
+	randomGeographicalThresholdGraph(sink, n, alpha, theta, lambda, dimension, order);
+}
+
+
+//! Creates a Geographical Threshold Graph with given weights. 
+/**
+ * @param sink is assigned the generated graph.
  * @param weights is array of weight assigned to nodes.
  * @param alpha is the model parameter.
  * @param theta is the threshold parameter.
  * @param lambda is the exponential distribution
  * @param dimension is the dimension of nodes to layed out.
  */
-void randomGeographicalThresholdWeightsGraph(Graph &G, Array<int> &weights, double alpha, double theta, double lambda = 1.0, int dimension = 2) {
+void randomGeographicalThresholdWeightsGraph(EdgeSink &sink, const Array<int> &weights, double alpha, double theta, double lambda, int dimension) {
 	OGDF_ASSERT(alpha > 0 && theta > 0 && lambda > 0);
 
-	G.clear();
-	if (weights.size() == 0) return;
+	int n = weights.size();
+	if (n == 0) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
 
 	// exponential generator for laying out points
-	default_random_engine generator;
+	RandomEngine generator(generatorSeed());
 	exponential_distribution<double> distribution(lambda);
 
-	// uniform generator for assigning weights
-	minstd_rand rng(randomSeed());
-	uniform_real_distribution<> dist(0, 1);
-
-	NodeArray<Array<double>> cord(G, Array<double>(dimension));
+	// coordinates of node i are cord[i*dimension] ... cord[i*dimension + dimension-1]
+	ScratchFrame scratch;
+	double *cord = scratch.allocate<double>((size_t)n * dimension);
 	double maxWeight = 0.0;
 
 	// adding n nodes to graph and calculating max weight
-	for (int i = 0; i < weights.size(); i++) {
-		G.newNode();
-		if (maxWeight > weights[i]) {
+	sink.reserve(n, 0);
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
+		if (maxWeight < weights[i]) {
 			maxWeight = weights[i];
 		}
 	}
 
 	// using exponential distribution to generate random points
-	for (node v : G.nodes) {
+	for (int v = 0; v < n; v++) {
 		for (int i = 0; i < dimension; i++){
-			cord[v][i] = distribution(generator);
+			cord[v*dimension + i] = distribution(generator);
 		}
 	}
 
-	int i, j;
-	node v, w;
-	for (i = 0, v = G.firstNode(); v; v = v->succ(), i++) {
-		for (j = i + 1, w = v->succ(); w; w = w->succ(), j++) {
+	// reporting the positions of the nodes
+	for (int v = 0; v < n; v++) {
+		sink.setPosition(v, cord + (size_t)v * dimension, dimension);
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	for (int i = rows.first; i < rows.second; i++) {
+		probe.pairs(n - i - 1);
+		for (int j = i + 1; j < n; j++) {
 			double distance = 0.0;
 			for (int k = 0; k < dimension; k++) {
-				distance += (cord[v][k] - cord[w][k])*(cord[v][k] - cord[w][k]);
+				double delta = cord[i*dimension + k] - cord[j*dimension + k];
+				distance += delta*delta;
 			}
 			distance = sqrt(distance);
 
 			if ((weights[i]/maxWeight + weights[j]/maxWeight) > theta*pow(distance, alpha)) {
-				G.newEdge(v, w);
+				sink.addEdge(i, j, distance);
+				probe.edges();
 			}
 		}
 	}
 
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Geographical Threshold Graph with given weights. 
+/**
+ * @param G is assigned the generated graph.
+ * @param weights is array of weight assigned to nodes.
+ * @param alpha is the model parameter.
+ * @param theta is the threshold parameter.
+ * @param lambda is the exponential distribution
+ * @param dimension is the dimension of nodes to layed out.
+ */
+void randomGeographicalThresholdWeightsGraph(Graph &G, Array<int> &weights, double alpha, double theta, double lambda, int dimension) {
+	G.clear();
+	GraphSink sink(G);
+	randomGeographicalThresholdWeightsGraph(sink, weights, alpha, theta, lambda, dimension);
+}
+
+//! Creates a Geographical Threshold Graph with given weights and assigns positions and edge lengths.
+/**
+ * @param G is assigned the generated graph.
+ * @param GA is assigned the positions of the nodes, of which x, y and z are the first three coordinates; it must belong to \p G.
+ * @param distance is assigned the distance between the endpoints of each edge.
+ * @param weights is array of weight assigned to nodes.
+ * @param alpha is the model parameter.
+ * @param theta is the threshold parameter.
+ * @param lambda is the exponential distribution
+ * @param dimension is the dimension of nodes to layed out.
+ */
+void randomGeographicalThresholdWeightsGraph(Graph &G, GraphAttributes &GA, EdgeArray<double> &distance, Array<int> &weights, double alpha, double theta, double lambda, int dimension) {
+	G.clear();
+	GraphSink sink(G, &distance, &GA);
+	randomGeographicalThresholdWeightsGraph(sink, weights, alpha, theta, lambda, dimension);
 }
 
+#ifndef OGDF_GENERATORS_LIBRARY
 int main(){
 	//! TODO: tests
 	Graph G;
@@ -167,3 +280,4 @@ int main(){
 
 	return 0;
 }
+#endif
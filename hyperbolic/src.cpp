@@ -0,0 +1,483 @@
+/*
+ * Hyperbolic Geometry of Complex Networks
+ * D. Krioukov, F. Papadopoulos, M. Kitsak, A. Vahdat, M. Boguna,
+ * Physical Review E 82, 036106, 2010
+ * Link: http://arxiv.org/abs/1006.5169
+ *
+ * Generating massive complex networks with hyperbolic geometry faster in practice
+ * M. von Looz, M. S. Oezdayi, S. Laue, H. Meyerhenke, HPEC 2016
+ * Link: http://arxiv.org/abs/1606.09481
+ *
+ * Random hyperbolic graph
+ * n points are placed in a disk of radius R of the hyperbolic plane. The
+ * angle of every point is uniform in [0, 2 pi), its radius r in [0, R) has
+ * density alpha * sinh(alpha * r) / (cosh(alpha * R) - 1), which gives a
+ * power-law degree distribution with exponent gamma = 2 * alpha + 1. In the
+ * threshold model, two points are adjacent if their hyperbolic distance d
+ * is at most R; at temperature T in (0, 1) they are adjacent with
+ * probability 1 / (1 + exp((d - R) / (2 * T))). R is chosen such that the
+ * expected average degree is the given one.
+ *
+ * The fast generator splits the disk into concentric bands and sorts the
+ * points of every band by angle. A point is only compared to the points of
+ * its own and the outer bands, and in the threshold model only to those
+ * within the largest angle at which a point on the inner boundary of the
+ * band can still be adjacent. Thus it runs in expected time O(n log n + m)
+ * for the threshold model. At positive temperature, the candidates of every
+ * band are split into angular ranges of doubling width, and in each range
+ * the pairs are drawn by geometric skipping with the largest probability of
+ * the range and accepted with the ratio of the actual one. The points are
+ * processed in parallel.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+
+#include "../common/BatchRandom.h"
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Parallel.h"
+#include "../common/Random.h"
+#include "../common/Shard.h"
+
+using namespace ogdf;
+
+//! Polar coordinates of the points, with cosh and sinh of the radii.
+struct HyperbolicPoints {
+	std::vector<double> angle, radius, coshRadius, sinhRadius;
+};
+
+//! Returns the radius at quantile \p q of the radial distribution of a disk of radius \p R.
+static double radiusAtQuantile(double q, double alpha, double R) {
+	if (alpha * R > 300) {
+		// cosh(alpha * R) is about exp(alpha * R) / 2
+		return std::max(0.0, R + log(q) / alpha);
+	}
+	return acosh(1.0 + q * (cosh(alpha * R) - 1.0)) / alpha;
+}
+
+//! Returns the largest angle between adjacent points with radii \p r and \p s in the threshold model.
+static double maxAngle(double r, double s, double R) {
+	if (r + s <= R) {
+		return M_PI;
+	}
+	double cosine = (cosh(r) * cosh(s) - cosh(R)) / (sinh(r) * sinh(s));
+	return acos(std::min(1.0, std::max(-1.0, cosine)));
+}
+
+//! Returns the expected degree of a point in the threshold model on \p n points in a disk of radius \p R.
+/**
+ * The angle between two points is uniform, so points with radii r and s
+ * are adjacent with probability maxAngle(r, s) / pi; this is integrated
+ * over the quantiles of both radii.
+ */
+static double expectedDegree(int n, double alpha, double R) {
+	// The expected degree of a point at quantile q grows like q^(-1 / (2 alpha))
+	// towards the center; substituting q = u^power makes the integrand bounded.
+	const int steps = 64;
+	double power = std::max(2.0, 2 * alpha / (2 * alpha - 1) + 1);
+	double radius[steps], weight[steps];
+	for (int i = 0; i < steps; i++) {
+		double u = (i + 0.5) / steps;
+		radius[i] = radiusAtQuantile(pow(u, power), alpha, R);
+		weight[i] = power * pow(u, power - 1) / steps;
+	}
+	double sum = 0.0;
+	for (int i = 0; i < steps; i++) {
+		sum += weight[i] * weight[i] * maxAngle(radius[i], radius[i], R);
+		for (int j = i + 1; j < steps; j++) {
+			sum += 2 * weight[i] * weight[j] * maxAngle(radius[i], radius[j], R);
+		}
+	}
+	return (n - 1) * sum / M_PI;
+}
+
+//! Returns the radius of the disk that gives the expected average degree \p averageDegree.
+/**
+ * At temperature T, the expected degree is asymptotically pi * T / sin(pi * T)
+ * times that of the threshold model, see Krioukov et al., so the threshold
+ * model is solved for the correspondingly smaller degree. The last radius
+ * is remembered, since the search dominates the running time for small n.
+ */
+static double diskRadius(int n, double averageDegree, double alpha, double temperature) {
+	struct Solution {
+		int n = -1;
+		double averageDegree, alpha, temperature, R;
+	};
+	static thread_local Solution last;
+	if (last.n == n && last.averageDegree == averageDegree && last.alpha == alpha && last.temperature == temperature) {
+		return last.R;
+	}
+
+	double target = averageDegree;
+	if (temperature > 0) {
+		target *= sin(M_PI * temperature) / (M_PI * temperature);
+	}
+
+	// the expected degree decreases from n - 1 at R = 0, where the graph is complete
+	double lower = 0.0, upper = 0.0;
+	if (expectedDegree(n, alpha, 0.0) > target) {
+		upper = 2 * log(n) + 10;
+		while (expectedDegree(n, alpha, upper) > target) {
+			lower = upper;
+			upper *= 2;
+		}
+		for (int i = 0; i < 40; i++) {
+			double middle = (lower + upper) / 2;
+			(expectedDegree(n, alpha, middle) > target ? lower : upper) = middle;
+		}
+	}
+
+	last = {n, averageDegree, alpha, temperature, upper};
+	return upper;
+}
+
+//! Draws the points; point v is drawn from block v of stream 0, so they can be drawn in parallel.
+static void samplePoints(HyperbolicPoints &points, uint64_t seed, int n, double alpha, double R) {
+	points.angle.resize(n);
+	points.radius.resize(n);
+	points.coshRadius.resize(n);
+	points.sinhRadius.resize(n);
+
+	parallelFor(n, parallelChunks(n, 4096), [&](int, size_t begin, size_t end) {
+		for (size_t v = begin; v < end; v++) {
+			CounterStream random(seed, 0, v);
+			points.angle[v] = 2 * M_PI * random.uniform();
+			points.radius[v] = radiusAtQuantile(1.0 - random.uniform(), alpha, R);
+			points.coshRadius[v] = cosh(points.radius[v]);
+			points.sinhRadius[v] = sinh(points.radius[v]);
+		}
+	});
+}
+
+//! Returns cosh of the distance of \p v < \p w; both generators compute it alike, so they agree exactly.
+static double coshDistance(const HyperbolicPoints &points, int v, int w) {
+	return points.coshRadius[v] * points.coshRadius[w]
+		- points.sinhRadius[v] * points.sinhRadius[w] * cos(points.angle[v] - points.angle[w]);
+}
+
+//! Returns the probability that two points at cosh distance \p coshD are adjacent at \p temperature > 0.
+static double edgeProbability(double coshD, double R, double temperature) {
+	double d = acosh(std::max(1.0, coshD));
+	return 1.0 / (1.0 + exp((d - R) / (2 * temperature)));
+}
+
+static bool validParameters(double averageDegree, double exponent, double temperature) {
+	return averageDegree > 0 && exponent > 2 && temperature >= 0 && temperature < 1;
+}
+
+//! Creates a random hyperbolic graph by examining all pairs of nodes.
+/**
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param averageDegree is the expected average degree.
+ * @param exponent is the exponent gamma > 2 of the power-law degree distribution.
+ * @param temperature is 0 for the threshold model or in (0, 1).
+ */
+void randomHyperbolicGraph(EdgeSink &sink, int n, double averageDegree, double exponent, double temperature) {
+	OGDF_ASSERT(n >= 0);
+
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(averageDegree, exponent, temperature)) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
+	double alpha = (exponent - 1) / 2;
+	double R = diskRadius(n, averageDegree, alpha, temperature);
+	double coshR = cosh(R);
+
+	HyperbolicPoints points;
+	samplePoints(points, seed, n, alpha, R);
+
+	// adding n nodes to graph
+	sink.reserve(n, (long long)(averageDegree * n / 2));
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	for (int v = rows.first; v < rows.second; v++) {
+		probe.pairs(n - v - 1);
+		// the pairs {v, w}, w > v, are decided by block v of stream 1
+		BatchRandom random(seed, 1, v);
+		for (int w = v + 1; w < n; w++) {
+			double coshD = coshDistance(points, v, w);
+			bool adjacent = temperature == 0
+				? coshD <= coshR
+				: random.next() < edgeProbability(coshD, R, temperature);
+			if (adjacent) {
+				sink.addEdge(v, w);
+				probe.edges();
+			}
+		}
+	}
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a random hyperbolic graph by examining all pairs of nodes.
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param averageDegree is the expected average degree.
+ * @param exponent is the exponent gamma > 2 of the power-law degree distribution.
+ * @param temperature is 0 for the threshold model or in (0, 1).
+ */
+void randomHyperbolicGraph(Graph &G, int n, double averageDegree, double exponent, double temperature) {
+	G.clear();
+	GraphSink sink(G);
+	randomHyperbolicGraph(sink, n, averageDegree, exponent, temperature);
+}
+
+//! The points of a band sorted by angle.
+struct HyperbolicBand {
+	double inner, outer;
+	double coshInner, sinhInner;
+	std::vector<double> angle;
+	std::vector<int> node;
+};
+
+//! Calls \p f(i) for the positions i in \p band of the points with angles in [\p lower, \p upper] modulo 2 pi.
+template<typename F>
+static void forEachInArc(const HyperbolicBand &band, double lower, double upper, F f) {
+	auto scan = [&](double from, double to) {
+		auto first = std::lower_bound(band.angle.begin(), band.angle.end(), from);
+		auto last = std::upper_bound(first, band.angle.end(), to);
+		for (auto it = first; it != last; ++it) {
+			f((size_t)(it - band.angle.begin()));
+		}
+	};
+	if (lower < 0) {
+		scan(lower + 2 * M_PI, 2 * M_PI);
+		scan(0, upper);
+	} else if (upper >= 2 * M_PI) {
+		scan(lower, 2 * M_PI);
+		scan(0, upper - 2 * M_PI);
+	} else {
+		scan(lower, upper);
+	}
+}
+
+//! Returns cosh of the smallest distance between point \p v and the points of \p band at angle \p delta.
+static double minCoshDistance(const HyperbolicPoints &points, int v, const HyperbolicBand &band, double delta) {
+	double r = points.radius[v];
+	if (r <= band.inner) {
+		return points.coshRadius[v] * band.coshInner - points.sinhRadius[v] * band.sinhInner * cos(delta);
+	}
+	// for fixed r and delta, the distance is smallest at tanh(s) = tanh(r) cos(delta) <= tanh(r)
+	double s = cos(delta) > 0 ? atanh(tanh(r) * cos(delta)) : 0.0;
+	s = std::min(std::max(s, band.inner), band.outer);
+	return points.coshRadius[v] * cosh(s) - points.sinhRadius[v] * sinh(s) * cos(delta);
+}
+
+//! Creates a random hyperbolic graph in expected time O(n log n + m) with angular bands.
+/**
+ * Uses the same points as randomHyperbolicGraph() for the same seed, so in
+ * the threshold model both generate the same edges; at positive temperature
+ * the pairs are decided with other random numbers, but by the same
+ * probabilities. The bands are processed on up to generatorThreads() threads.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param averageDegree is the expected average degree.
+ * @param exponent is the exponent gamma > 2 of the power-law degree distribution.
+ * @param temperature is 0 for the threshold model or in (0, 1).
+ */
+void randomHyperbolicGraphFast(EdgeSink &sink, int n, double averageDegree, double exponent, double temperature) {
+	OGDF_ASSERT(n >= 0);
+
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(averageDegree, exponent, temperature)) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
+	double alpha = (exponent - 1) / 2;
+	double R = diskRadius(n, averageDegree, alpha, temperature);
+	double coshR = cosh(R);
+
+	HyperbolicPoints points;
+	samplePoints(points, seed, n, alpha, R);
+
+	// the bands get narrower towards the rim, where most points lie
+	const double ratio = 0.9;
+	int bandCount = std::max(1, (int)std::ceil(std::log2((double)n)));
+	std::vector<HyperbolicBand> bands(bandCount);
+	for (int i = 0; i < bandCount; i++) {
+		bands[i].inner = R * (1 - pow(ratio, i)) / (1 - pow(ratio, bandCount));
+		bands[i].outer = R * (1 - pow(ratio, i + 1)) / (1 - pow(ratio, bandCount));
+	}
+	bands.back().outer = R;
+	for (HyperbolicBand &band : bands) {
+		band.coshInner = cosh(band.inner);
+		band.sinhInner = sinh(band.inner);
+	}
+
+	std::vector<int> bandOf(n);
+	std::vector<std::pair<double, int>> order(n);
+	for (int v = 0; v < n; v++) {
+		order[v] = {points.angle[v], v};
+	}
+	std::sort(order.begin(), order.end());
+	for (const std::pair<double, int> &point : order) {
+		int v = point.second;
+		int i = 0;
+		while (i + 1 < bandCount && points.radius[v] >= bands[i + 1].inner) {
+			i++;
+		}
+		bandOf[v] = i;
+		bands[i].angle.push_back(point.first);
+		bands[i].node.push_back(v);
+	}
+
+	// adding n nodes to graph
+	sink.reserve(n, (long long)(averageDegree * n / 2));
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+
+	// every pair is decided by the point in the inner band, or the smaller one within a band
+	int chunks = parallelChunks(n, 1024);
+	std::vector<std::vector<std::pair<int, int>>> edges(chunks);
+	std::vector<uint64_t> candidates(chunks, 0);
+
+	parallelFor(n, chunks, [&](int t, size_t begin, size_t end) {
+		for (int v = (int)begin; v < (int)end; v++) {
+			double r = points.radius[v];
+			double phi = points.angle[v];
+			// the pairs of v are decided by block v of stream 1
+			CounterStream random(seed, 1, v);
+
+			auto decide = [&](const HyperbolicBand &band, size_t i, bool sameBand, double bound) {
+				int w = band.node[i];
+				if (sameBand && w <= v) {
+					return;
+				}
+				candidates[t]++;
+				int a = std::min(v, w), b = std::max(v, w);
+				double coshD = coshDistance(points, a, b);
+				bool adjacent = temperature == 0
+					? coshD <= coshR
+					: random.uniform() * bound < edgeProbability(coshD, R, temperature);
+				if (adjacent) {
+					edges[t].emplace_back(a, b);
+				}
+			};
+
+			for (int j = bandOf[v]; j < bandCount; j++) {
+				const HyperbolicBand &band = bands[j];
+				size_t size = band.angle.size();
+				if (size == 0) {
+					continue;
+				}
+				bool sameBand = j == bandOf[v];
+
+				if (temperature == 0) {
+					// with some slack, so that rounding cannot lose a pair on the boundary
+					double delta = maxAngle(r, band.inner, R) * (1 + 1e-9) + 1e-12;
+					if (delta >= M_PI) {
+						for (size_t i = 0; i < size; i++) {
+							decide(band, i, sameBand, 1.0);
+						}
+					} else {
+						forEachInArc(band, phi - delta, phi + delta, [&](size_t i) {
+							decide(band, i, sameBand, 1.0);
+						});
+					}
+					continue;
+				}
+
+				// the points ahead of and behind v, each ordered by their angle to v
+				size_t first = std::lower_bound(band.angle.begin(), band.angle.end(), phi) - band.angle.begin();
+				double opposite = phi + M_PI;
+				size_t aheadCount = opposite < 2 * M_PI
+					? (std::upper_bound(band.angle.begin(), band.angle.end(), opposite) - band.angle.begin()) - first
+					: size - first + (std::upper_bound(band.angle.begin(), band.angle.end(), opposite - 2 * M_PI) - band.angle.begin());
+
+				for (int side = 0; side < 2; side++) {
+					size_t count = side == 0 ? aheadCount : size - aheadCount;
+					auto position = [&](size_t k) {
+						return side == 0 ? (first + k) % size : (first + 2 * size - 1 - k) % size;
+					};
+					auto angleTo = [&](size_t k) {
+						double a = side == 0 ? band.angle[position(k)] - phi : phi - band.angle[position(k)];
+						return a < 0 ? a + 2 * M_PI : a;
+					};
+
+					// Geometric skipping with a bound on the probabilities of all
+					// points from k on, which is lowered to the bound at the angle
+					// of every point skipped to, since the probabilities decrease
+					// with the angle. Every point is still skipped to with the
+					// bound at that time and accepted with the ratio, so it is
+					// adjacent with its own probability.
+					double bound = edgeProbability(minCoshDistance(points, v, band, 0.0), R, temperature);
+					for (size_t k = 0; k < count && bound > 0.0; k++) {
+						if (bound < 1.0) {
+							double skip = std::floor(log(1.0 - random.uniform()) / log1p(-bound));
+							if (skip >= (double)(count - k)) {
+								break;
+							}
+							k += (size_t)skip;
+						}
+						decide(band, position(k), sameBand, bound);
+						bound = edgeProbability(minCoshDistance(points, v, band, angleTo(k)), R, temperature);
+					}
+				}
+			}
+		}
+	});
+
+	for (int t = 0; t < chunks; t++) {
+		probe.pairs(candidates[t]);
+		probe.rejections(candidates[t] - edges[t].size());
+		for (const std::pair<int, int> &e : edges[t]) {
+			sink.addEdge(e.first, e.second);
+			probe.edges();
+		}
+	}
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a random hyperbolic graph in expected time O(n log n + m) with angular bands.
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param averageDegree is the expected average degree.
+ * @param exponent is the exponent gamma > 2 of the power-law degree distribution.
+ * @param temperature is 0 for the threshold model or in (0, 1).
+ */
+void randomHyperbolicGraphFast(Graph &G, int n, double averageDegree, double exponent, double temperature) {
+	G.clear();
+	GraphSink sink(G);
+	randomHyperbolicGraphFast(sink, n, averageDegree, exponent, temperature);
+}
+
+#ifndef OGDF_GENERATORS_LIBRARY
+int main(){
+	Graph G;
+	randomHyperbolicGraph(G, 1000, 10, 3);
+	std::cout << G.numberOfEdges() << std::endl;
+	randomHyperbolicGraphFast(G, 1000, 10, 3);
+	std::cout << G.numberOfEdges() << std::endl;
+	randomHyperbolicGraphFast(G, 1000, 10, 3, 0.5);
+	std::cout << G.numberOfEdges() << std::endl;
+
+	return 0;
+}
+#endif
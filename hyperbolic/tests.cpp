@@ -0,0 +1,134 @@
+#include "bandit/bandit.h"
+#include "ogdf/basic/Graph.h"
+
+#include "../common/Ensemble.h"
+#include "../common/Generators.h"
+#include "../common/Parallel.h"
+#include "../common/Random.h"
+#include "../tests/edges.h"
+#include "../tests/statistics.h"
+
+using namespace ogdf;
+using namespace ogdf::statistics;
+using namespace bandit;
+
+using namespace ogdf::testing;
+
+//! Number of samples drawn from each generator when comparing distributions.
+static const int numberOfSamples = 3000;
+
+//! Significance level of the equivalence tests.
+static const double level = 1e-3;
+
+static void describeThreshold(int n, double averageDegree, double exponent) {
+	std::string name = "on " + std::to_string(n) + " nodes with average degree "
+		+ std::to_string(averageDegree) + " and exponent " + std::to_string(exponent);
+
+	describe(name.c_str(), [&](){
+		it("generates the same edges as randomHyperbolicGraph", [&](){
+			for (uint64_t seed = 1; seed <= 5; seed++) {
+				Edges expected = sortedEdges(generateEdges(seed, [&](EdgeSink &sink) {
+					randomHyperbolicGraph(sink, n, averageDegree, exponent);
+				}, 1));
+				Edges actual = sortedEdges(generateEdges(seed, [&](EdgeSink &sink) {
+					randomHyperbolicGraphFast(sink, n, averageDegree, exponent);
+				}, 1));
+				AssertThat(actual == expected, IsTrue());
+			}
+		});
+		it("generates simple graphs", [&](){
+			Edges edges = sortedEdges(generateEdges(7, [&](EdgeSink &sink) {
+				randomHyperbolicGraphFast(sink, n, averageDegree, exponent);
+			}, 1));
+			AssertThat(std::adjacent_find(edges.begin(), edges.end()) == edges.end(), IsTrue());
+			for (const auto &e : edges) {
+				AssertThat(e.first < e.second, IsTrue());
+			}
+		});
+	});
+}
+
+static void describeEquivalence(int n, double averageDegree, double exponent, double temperature) {
+	std::string name = "on " + std::to_string(n) + " nodes at temperature " + std::to_string(temperature);
+
+	describe(name.c_str(), [&](){
+		GraphSamples expected = sampleGraphs(n, numberOfSamples, 4711, [&](EdgeSink &sink) {
+			randomHyperbolicGraph(sink, n, averageDegree, exponent, temperature);
+		});
+		GraphSamples actual = sampleGraphs(n, numberOfSamples, 1147, [&](EdgeSink &sink) {
+			randomHyperbolicGraphFast(sink, n, averageDegree, exponent, temperature);
+		});
+
+		it("connects every pair with the same probability", [&](){
+			AssertThat(comparePairMarginals(expected, actual), IsGreaterThan(level));
+		});
+		it("has the same degree distribution", [&](){
+			AssertThat(compareDegrees(expected, actual), IsGreaterThan(level));
+		});
+		it("has the same distribution of the number of edges", [&](){
+			AssertThat(compareEdgeCounts(expected, actual), IsGreaterThan(level));
+		});
+	});
+}
+
+go_bandit([](){
+	describe("randomHyperbolicGraph", [&](){
+		it("generates a graph with n nodes", [&](){
+			for (int n = 1; n < 50; n++) {
+				Graph G;
+				randomHyperbolicGraph(G, n, 4, 2.5);
+				AssertThat(G.numberOfNodes(), Equals(n));
+				randomHyperbolicGraph(G, n, 4, 2.5, 0.5);
+				AssertThat(G.numberOfNodes(), Equals(n));
+			}
+		});
+		it("yields the empty graph for invalid parameters", [&](){
+			Graph G;
+			randomHyperbolicGraph(G, 10, 4, 2.0);
+			AssertThat(G.numberOfNodes(), Equals(0));
+			randomHyperbolicGraph(G, 10, 4, 2.5, 1.0);
+			AssertThat(G.numberOfNodes(), Equals(0));
+			randomHyperbolicGraph(G, 10, 0, 2.5);
+			AssertThat(G.numberOfNodes(), Equals(0));
+		});
+	});
+
+	describe("randomHyperbolicGraphFast", [&](){
+		it("generates a graph with n nodes", [&](){
+			for (int n = 1; n < 50; n++) {
+				Graph G;
+				randomHyperbolicGraphFast(G, n, 4, 2.5);
+				AssertThat(G.numberOfNodes(), Equals(n));
+				randomHyperbolicGraphFast(G, n, 4, 2.5, 0.5);
+				AssertThat(G.numberOfNodes(), Equals(n));
+			}
+		});
+
+		describeThreshold(2, 1, 3);
+		describeThreshold(100, 8, 2.2);
+		describeThreshold(1000, 6, 3);
+		describeThreshold(2000, 20, 5);
+
+		it("generates the same edges on any number of threads", [&](){
+			for (double temperature : {0.0, 0.4}) {
+				auto generate = [&](EdgeSink &sink) { randomHyperbolicGraphFast(sink, 5000, 10, 2.5, temperature); };
+				AssertThat(sortedEdges(generateEdges(3, generate, 4)) == sortedEdges(generateEdges(3, generate, 1)), IsTrue());
+			}
+		});
+
+		it("has roughly the given average degree", [&](){
+			for (double temperature : {0.0, 0.3}) {
+				Edges edges = sortedEdges(generateEdges(5, [&](EdgeSink &sink) {
+					randomHyperbolicGraphFast(sink, 20000, 10, 3, temperature);
+				}, 1));
+				double averageDegree = 2.0 * edges.size() / 20000;
+				AssertThat(averageDegree, IsGreaterThan(8.0));
+				AssertThat(12.0, IsGreaterThan(averageDegree));
+			}
+		});
+
+		describeEquivalence(12, 3, 2.5, 0.5);
+		describeEquivalence(30, 4, 3, 0.2);
+		describeEquivalence(30, 4, 2.2, 0.8);
+	});
+});
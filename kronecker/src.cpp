@@ -0,0 +1,386 @@
+/*
+ * Kronecker Graphs: An Approach to Modeling Networks
+ * J. Leskovec, D. Chakrabarti, J. Kleinberg, C. Faloutsos, Z. Ghahramani,
+ * Journal of Machine Learning Research 11, 2010
+ * Link: http://www.jmlr.org/papers/volume11/leskovec10a/leskovec10a.pdf
+ *
+ * R-MAT: A Recursive Model for Graph Mining
+ * D. Chakrabarti, Y. Zhan, C. Faloutsos, SIAM International Conference on Data Mining, 2004
+ * Link: http://www.cs.cmu.edu/~christos/PUBLICATIONS/siam04.pdf
+ *
+ * An In-Depth Analysis of Stochastic Kronecker Graphs
+ * C. Seshadhri, A. Pinar, T. G. Kolda, Journal of the ACM 60, 2013
+ * Link: http://arxiv.org/abs/1102.5046
+ *
+ * Stochastic Kronecker graph
+ * Given a k x k initiator matrix P of nonnegative entries and a scale s,
+ * the graph has k^s nodes, and each of its m edges is drawn independently
+ * by descending s times into one of the k^2 cells of the adjacency matrix,
+ * cell (i, j) with probability P[i][j] / sum(P). The node indices are the
+ * base-k numbers formed by the row and column indices of the descent. R-MAT
+ * is the case k = 2; Graph500 uses P = (0.57, 0.19; 0.19, 0.05) and
+ * m = 16 * 2^s. Noisy stochastic Kronecker graphs perturb the initiator of
+ * every level to smooth out the oscillations of the degree distribution.
+ *
+ * Every 4096 edges are drawn from a random number block of their own, so
+ * the edges are drawn in parallel. Since nodes with similar indices have similar
+ * degrees, the indices can be scrambled by a random permutation. Removing
+ * loops and multiple edges sorts the edges with a parallel radix sort, which
+ * keeps all m edges as 64-bit keys plus a buffer of the same size, 16 bytes
+ * per edge drawn. Without it, rounds of blocks are drawn in parallel and
+ * written in order, so memory does not grow with m.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+
+#include "../common/BatchRandom.h"
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Parallel.h"
+#include "../common/Random.h"
+
+using namespace ogdf;
+
+//! Initiators of every level, as the cumulative probabilities of their cells.
+struct KroneckerLevels {
+	int k;
+	int scale;
+	//! Number of bits of the random numbers that choose the cells.
+	static constexpr int bits = 26;
+	//! threshold[l * k * k + c] is the upper end of cell c at level l as a multiple of 2^-bits.
+	std::vector<uint64_t> threshold;
+	//! Row and column of every cell.
+	std::vector<int> row, col;
+
+	KroneckerLevels(int size, int levels) : k(size), scale(levels), threshold((size_t)levels * size * size) {
+		for (int c = 0; c < k * k; c++) {
+			row.push_back(c / k);
+			col.push_back(c % k);
+		}
+	}
+
+	//! Sets the initiator of level \p l to the \p k * \p k nonnegative weights \p weight, which must not all be 0.
+	void setLevel(int l, const double *weight) {
+		double total = 0.0;
+		for (int c = 0; c < k * k; c++) {
+			total += weight[c];
+		}
+		double sum = 0.0;
+		for (int c = 0; c < k * k; c++) {
+			sum += weight[c];
+			threshold[(size_t)l * k * k + c] = (uint64_t)std::ldexp(sum / total, bits);
+		}
+		// no random number reaches beyond the last cell
+		threshold[(size_t)l * k * k + k * k - 1] = (uint64_t)1 << bits;
+	}
+};
+
+//! Random permutation of [0, n), a keyed bijection of the smallest enclosing power of two restricted by cycle walking.
+class NodeScrambler {
+	uint64_t m_n, m_mask;
+	uint64_t m_multiplier[2], m_offset[2];
+	int m_shift;
+
+	uint64_t permute(uint64_t x) const {
+		// odd multiplications, additions and x ^= x >> s are bijections modulo 2^bits
+		for (int round = 0; round < 2; round++) {
+			x = (x * m_multiplier[round] + m_offset[round]) & m_mask;
+			x ^= x >> m_shift;
+		}
+		return x;
+	}
+
+public:
+	NodeScrambler(uint64_t n, CounterStream &random) : m_n(n) {
+		int bits = 0;
+		while (((uint64_t)1 << bits) < n) {
+			bits++;
+		}
+		m_mask = ((uint64_t)1 << bits) - 1;
+		m_shift = bits / 2 + 1;
+		for (int round = 0; round < 2; round++) {
+			m_multiplier[round] = random() | 1;
+			m_offset[round] = random();
+		}
+	}
+
+	uint64_t operator()(uint64_t x) const {
+		// at most half of the values are skipped, so this takes two steps on average
+		do {
+			x = permute(x);
+		} while (x >= m_n);
+		return x;
+	}
+};
+
+//! Draws \p m edges of the Kronecker graph with the initiators \p levels into \p sink.
+static void generateKroneckerGraph(EdgeSink &sink, GeneratorProbe &probe, uint64_t seed,
+		const KroneckerLevels &levels, long long m, bool scramble, bool deduplicate) {
+	int k = levels.k;
+	int cells = k * k;
+	int n = 1;
+	int bits = 0;
+	for (int l = 0; l < levels.scale; l++) {
+		n *= k;
+	}
+	while ((1LL << bits) < n) {
+		bits++;
+	}
+
+	// the permutation is drawn from block 1 of stream 0
+	CounterStream setupRandom(seed, 0, 1);
+	NodeScrambler scrambler(n, setupRandom);
+
+	// adding n nodes to graph
+	sink.reserve(n, m);
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+
+	// Edges e with e / edgesPerBlock = b are drawn from block b of stream 1,
+	// two levels from each double, and stored as (u << bits) | v.
+	const long long edgesPerBlock = 4096;
+	const uint64_t levelMask = ((uint64_t)1 << KroneckerLevels::bits) - 1;
+	const double scale = std::ldexp(1.0, 2 * KroneckerLevels::bits);
+	auto drawBlock = [&](long long b, uint64_t *out) {
+		BatchRandom random(seed, 1, b);
+		long long end = std::min(m, (b + 1) * edgesPerBlock);
+		for (long long e = b * edgesPerBlock; e < end; e++) {
+			uint64_t u = 0, v = 0, word = 0;
+			for (int l = 0; l < levels.scale; l++) {
+				if (l % 2 == 0) {
+					word = (uint64_t)(random.next() * scale);
+				}
+				uint64_t r = word & levelMask;
+				word >>= KroneckerLevels::bits;
+				// counting instead of searching avoids a mispredicted branch per level
+				const uint64_t *threshold = levels.threshold.data() + (size_t)l * cells;
+				int c = 0;
+				for (int i = 0; i < cells - 1; i++) {
+					c += r >= threshold[i];
+				}
+				u = u * k + levels.row[c];
+				v = v * k + levels.col[c];
+			}
+			if (scramble) {
+				u = scrambler(u);
+				v = scrambler(v);
+			}
+			if (deduplicate && u > v) {
+				std::swap(u, v);
+			}
+			*out++ = (u << bits) | v;
+		}
+	};
+
+	long long blocks = (m + edgesPerBlock - 1) / edgesPerBlock;
+	int chunks = parallelChunks(blocks, 4);
+	uint64_t mask = ((uint64_t)1 << bits) - 1;
+
+	if (!deduplicate) {
+		// drawing rounds of blocks in parallel and writing them in order, in memory independent of m
+		const long long blocksPerRound = 16LL * chunks;
+		std::vector<uint64_t> keys((size_t)std::min(m, blocksPerRound * edgesPerBlock));
+		for (long long first = 0; first < blocks; first += blocksPerRound) {
+			long long count = std::min(blocksPerRound, blocks - first);
+			parallelFor(count, parallelChunks(count, 4), [&](int, size_t begin, size_t end) {
+				for (size_t b = begin; b < end; b++) {
+					drawBlock(first + (long long)b, keys.data() + b * edgesPerBlock);
+				}
+			});
+			long long edges = std::min(m, (first + count) * edgesPerBlock) - first * edgesPerBlock;
+			for (long long e = 0; e < edges; e++) {
+				sink.addEdge((int)(keys[e] >> bits), (int)(keys[e] & mask));
+			}
+			probe.edges(edges);
+		}
+
+		probe.phase(GeneratorStats::Phase::Finish);
+		sink.finish();
+		return;
+	}
+
+	// all m keys and the buffer of the radix sort, 16 bytes per edge drawn
+	std::vector<uint64_t> keys(m);
+	parallelFor(blocks, chunks, [&](int, size_t beginBlock, size_t endBlock) {
+		for (size_t b = beginBlock; b < endBlock; b++) {
+			drawBlock((long long)b, keys.data() + b * edgesPerBlock);
+		}
+	});
+
+	parallelRadixSort(keys, 2 * bits);
+	for (size_t e = 0; e < keys.size(); e++) {
+		int u = (int)(keys[e] >> bits), v = (int)(keys[e] & mask);
+		if (u == v || (e > 0 && keys[e] == keys[e - 1])) {
+			probe.rejections();
+			continue;
+		}
+		sink.addEdge(u, v);
+		probe.edges();
+	}
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Returns k if \p initiator has k * k nonnegative entries for some k >= 2, not all 0, and 0 otherwise.
+static int initiatorSize(const Array<double> &initiator) {
+	int k = 0;
+	while (k * k < initiator.size()) {
+		k++;
+	}
+	double total = 0.0;
+	for (double p : initiator) {
+		if (p < 0) {
+			return 0;
+		}
+		total += p;
+	}
+	return k >= 2 && k * k == initiator.size() && total > 0 ? k : 0;
+}
+
+//! Returns true if k^\p scale fits into an int.
+static bool validScale(int k, int scale) {
+	long long n = 1;
+	for (int l = 0; l < scale; l++) {
+		n *= k;
+		if (n > INT_MAX) {
+			return false;
+		}
+	}
+	return scale >= 0;
+}
+
+//! Creates a stochastic Kronecker graph.
+/**
+ * @param sink is assigned the generated graph.
+ * @param initiator holds the k * k nonnegative weights of the initiator matrix, row by row.
+ * @param scale is the number of Kronecker products; the graph has k^scale nodes.
+ * @param m is the number of edges drawn.
+ * @param scramble permutes the node indices randomly.
+ * @param deduplicate removes loops and multiple edges, the remaining edges {u, v} are written as u < v; this takes 16 bytes of memory per edge drawn.
+ */
+void randomKroneckerGraph(EdgeSink &sink, const Array<double> &initiator, int scale, long long m, bool scramble, bool deduplicate) {
+	int k = initiatorSize(initiator);
+
+	// invalid parameters yield the empty graph
+	if (k == 0 || !validScale(k, scale) || m < 0) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
+
+	KroneckerLevels levels(k, scale);
+	std::vector<double> weight;
+	for (double p : initiator) {
+		weight.push_back(p);
+	}
+	for (int l = 0; l < scale; l++) {
+		levels.setLevel(l, weight.data());
+	}
+
+	generateKroneckerGraph(sink, probe, seed, levels, m, scramble, deduplicate);
+}
+
+//! Creates a stochastic Kronecker graph.
+/**
+ * @param G is assigned the generated graph.
+ * @param initiator holds the k * k nonnegative weights of the initiator matrix, row by row.
+ * @param scale is the number of Kronecker products; the graph has k^scale nodes.
+ * @param m is the number of edges drawn.
+ * @param scramble permutes the node indices randomly.
+ * @param deduplicate removes loops and multiple edges, which takes 16 bytes of memory per edge drawn.
+ */
+void randomKroneckerGraph(Graph &G, const Array<double> &initiator, int scale, long long m, bool scramble, bool deduplicate) {
+	G.clear();
+	GraphSink sink(G);
+	randomKroneckerGraph(sink, initiator, scale, m, scramble, deduplicate);
+}
+
+//! Creates an R-MAT graph, optionally with the noise of noisy stochastic Kronecker graphs.
+/**
+ * At every level, the initiator (a, b; c, d), d = 1 - a - b - c, is replaced by
+ * (a - 2 mu a / (a + d), b + mu; c + mu, d - 2 mu d / (a + d)) for a mu drawn
+ * uniformly from [-noise, noise].
+ *
+ * @param sink is assigned the generated graph.
+ * @param scale is the binary logarithm of the number of nodes, at most 30.
+ * @param edgeFactor is the number of edges drawn per node.
+ * @param a is the probability of the upper left quadrant.
+ * @param b is the probability of the upper right quadrant.
+ * @param c is the probability of the lower left quadrant.
+ * @param noise is in [0, min(b, c, (a + d) / 2)].
+ * @param scramble permutes the node indices randomly.
+ * @param deduplicate removes loops and multiple edges, the remaining edges {u, v} are written as u < v; this takes 16 bytes of memory per edge drawn.
+ */
+void randomRMatGraph(EdgeSink &sink, int scale, int edgeFactor, double a, double b, double c, double noise, bool scramble, bool deduplicate) {
+	double d = 1.0 - a - b - c;
+
+	// invalid parameters yield the empty graph
+	if (!validScale(2, scale) || edgeFactor < 0 || a < 0 || b < 0 || c < 0 || d < 0
+	    || noise < 0 || noise > std::min(std::min(b, c), (a + d) / 2)) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
+
+	// the noise of every level is drawn from block 0 of stream 0
+	CounterStream random(seed, 0, 0);
+	KroneckerLevels levels(2, scale);
+	for (int l = 0; l < scale; l++) {
+		double mu = noise * (2 * random.uniform() - 1);
+		double weight[4] = {a - 2 * mu * a / (a + d), b + mu, c + mu, d - 2 * mu * d / (a + d)};
+		levels.setLevel(l, weight);
+	}
+
+	generateKroneckerGraph(sink, probe, seed, levels, (long long)edgeFactor << scale, scramble, deduplicate);
+}
+
+//! Creates an R-MAT graph, optionally with the noise of noisy stochastic Kronecker graphs.
+/**
+ * @param G is assigned the generated graph.
+ * @param scale is the binary logarithm of the number of nodes, at most 30.
+ * @param edgeFactor is the number of edges drawn per node.
+ * @param a is the probability of the upper left quadrant.
+ * @param b is the probability of the upper right quadrant.
+ * @param c is the probability of the lower left quadrant.
+ * @param noise is in [0, min(b, c, (a + d) / 2)].
+ * @param scramble permutes the node indices randomly.
+ * @param deduplicate removes loops and multiple edges, which takes 16 bytes of memory per edge drawn.
+ */
+void randomRMatGraph(Graph &G, int scale, int edgeFactor, double a, double b, double c, double noise, bool scramble, bool deduplicate) {
+	G.clear();
+	GraphSink sink(G);
+	randomRMatGraph(sink, scale, edgeFactor, a, b, c, noise, scramble, deduplicate);
+}
+
+#ifndef OGDF_GENERATORS_LIBRARY
+int main(){
+	Graph G;
+	randomRMatGraph(G, 12);
+	std::cout << G.numberOfNodes() << " " << G.numberOfEdges() << std::endl;
+	randomRMatGraph(G, 12, 16, 0.57, 0.19, 0.19, 0.1);
+	std::cout << G.numberOfNodes() << " " << G.numberOfEdges() << std::endl;
+
+	Array<double> initiator(9);
+	for (int i = 0; i < 9; i++) {
+		initiator[i] = i + 1;
+	}
+	randomKroneckerGraph(G, initiator, 6, 5000);
+	std::cout << G.numberOfNodes() << " " << G.numberOfEdges() << std::endl;
+
+	return 0;
+}
+#endif
@@ -0,0 +1,162 @@
+#include "bandit/bandit.h"
+#include "ogdf/basic/Graph.h"
+
+#include "../common/Ensemble.h"
+#include "../common/Generators.h"
+#include "../common/Parallel.h"
+#include "../common/Random.h"
+#include "../tests/edges.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+using namespace ogdf::testing;
+
+//! Returns the sorted degrees of the nodes 0, ..., n-1 in \p edges.
+static std::vector<int> sortedDegrees(int n, const Edges &edges) {
+	std::vector<int> degree(n, 0);
+	for (const auto &e : edges) {
+		degree[e.first]++;
+		degree[e.second]++;
+	}
+	std::sort(degree.begin(), degree.end());
+	return degree;
+}
+
+go_bandit([](){
+	describe("parallelRadixSort", [&](){
+		it("sorts like std::sort on any number of threads", [&](){
+			for (int threads : {1, 3, 8}) {
+				CounterStream random(threads, 0, 0);
+				std::vector<uint64_t> keys(300000);
+				for (uint64_t &key : keys) {
+					key = random() >> 21;
+				}
+				std::vector<uint64_t> expected = keys;
+				std::sort(expected.begin(), expected.end());
+				ThreadLimit limit(threads);
+				parallelRadixSort(keys, 43);
+				AssertThat(keys == expected, IsTrue());
+			}
+		});
+	});
+
+	describe("randomRMatGraph", [&](){
+		it("generates 2^scale nodes and edgeFactor * 2^scale edges without deduplication", [&](){
+			for (int scale = 0; scale < 8; scale++) {
+				Graph G;
+				randomRMatGraph(G, scale, 4, 0.57, 0.19, 0.19, 0.0, true, false);
+				AssertThat(G.numberOfNodes(), Equals(1 << scale));
+				AssertThat(G.numberOfEdges(), Equals(4 << scale));
+			}
+		});
+
+		it("generates simple graphs with deduplication", [&](){
+			Edges edges = generateEdges(1, [](EdgeSink &sink) { randomRMatGraph(sink, 12, 16, 0.57, 0.19, 0.19, 0.05); }, 4);
+			AssertThat(edges.empty(), IsFalse());
+			for (size_t i = 0; i < edges.size(); i++) {
+				AssertThat(edges[i].first < edges[i].second, IsTrue());
+				AssertThat(i == 0 || edges[i - 1] < edges[i], IsTrue());
+			}
+		});
+
+		it("draws the quadrants with the probabilities of the initiator", [&](){
+			const int m = 200000;
+			Edges edges = generateEdges(2, [](EdgeSink &sink) { randomRMatGraph(sink, 1, m / 2, 0.5, 0.2, 0.2, 0.0, false, false); }, 1);
+			double count[4] = {0, 0, 0, 0};
+			for (const auto &e : edges) {
+				count[2 * e.first + e.second]++;
+			}
+			double probability[4] = {0.5, 0.2, 0.2, 0.1};
+			for (int c = 0; c < 4; c++) {
+				double deviation = std::fabs(count[c] - m * probability[c]) / std::sqrt(m * probability[c] * (1 - probability[c]));
+				AssertThat(5.0, IsGreaterThan(deviation));
+			}
+		});
+
+		it("scrambles by a permutation of the nodes", [&](){
+			auto generate = [](bool scramble) {
+				return [scramble](EdgeSink &sink) { randomRMatGraph(sink, 10, 8, 0.57, 0.19, 0.19, 0.0, scramble, false); };
+			};
+			Edges plain = generateEdges(3, generate(false), 1);
+			Edges scrambled = generateEdges(3, generate(true), 1);
+			AssertThat(plain == scrambled, IsFalse());
+			AssertThat(sortedDegrees(1 << 10, plain) == sortedDegrees(1 << 10, scrambled), IsTrue());
+		});
+
+		it("generates the same edges on any number of threads", [&](){
+			auto generate = [](EdgeSink &sink) { randomRMatGraph(sink, 14, 16, 0.57, 0.19, 0.19, 0.1); };
+			AssertThat(generateEdges(4, generate, 1) == generateEdges(4, generate, 5), IsTrue());
+		});
+
+		it("writes the edges drawn in rounds in the same order on any number of threads", [&](){
+			// 256 blocks of edges, several rounds on any number of threads
+			auto generate = [](bool deduplicate) {
+				return [deduplicate](EdgeSink &sink) { randomRMatGraph(sink, 16, 16, 0.57, 0.19, 0.19, 0.0, true, deduplicate); };
+			};
+			Edges edges = generateEdges(5, generate(false), 1);
+			AssertThat(edges.size(), Equals((size_t)16 << 16));
+			AssertThat(generateEdges(5, generate(false), 3) == edges, IsTrue());
+			AssertThat(generateEdges(5, generate(false), 8) == edges, IsTrue());
+
+			// deduplication keeps exactly the distinct non-loops of the same draws
+			Edges simple;
+			for (auto e : edges) {
+				if (e.first == e.second) continue;
+				simple.emplace_back(std::min(e.first, e.second), std::max(e.first, e.second));
+			}
+			std::sort(simple.begin(), simple.end());
+			simple.erase(std::unique(simple.begin(), simple.end()), simple.end());
+			AssertThat(generateEdges(5, generate(true), 4) == simple, IsTrue());
+		});
+
+		it("yields the empty graph for invalid parameters", [&](){
+			Graph G;
+			randomRMatGraph(G, 31);
+			AssertThat(G.numberOfNodes(), Equals(0));
+			randomRMatGraph(G, 4, 16, 0.6, 0.3, 0.3);
+			AssertThat(G.numberOfNodes(), Equals(0));
+			randomRMatGraph(G, 4, 16, 0.57, 0.19, 0.19, 0.2);
+			AssertThat(G.numberOfNodes(), Equals(0));
+		});
+	});
+
+	describe("randomKroneckerGraph", [&](){
+		it("generates k^scale nodes", [&](){
+			Array<double> initiator(9);
+			for (int i = 0; i < 9; i++) {
+				initiator[i] = 1 + i % 4;
+			}
+			for (int scale = 0; scale < 6; scale++) {
+				Graph G;
+				randomKroneckerGraph(G, initiator, scale, 1000);
+				int n = 1;
+				for (int l = 0; l < scale; l++) {
+					n *= 3;
+				}
+				AssertThat(G.numberOfNodes(), Equals(n));
+			}
+		});
+
+		it("never uses cells of weight zero", [&](){
+			// only the diagonal, so every drawn edge is a loop
+			Array<double> initiator(4);
+			initiator[0] = 1;
+			initiator[1] = initiator[2] = 0;
+			initiator[3] = 2;
+			Edges edges = generateEdges(5, [&](EdgeSink &sink) { randomKroneckerGraph(sink, initiator, 8, 5000, true, false); }, 1);
+			AssertThat(edges.size(), Equals(5000u));
+			for (const auto &e : edges) {
+				AssertThat(e.first, Equals(e.second));
+			}
+		});
+
+		it("yields the empty graph for invalid initiators", [&](){
+			Graph G;
+			Array<double> initiator(3);
+			initiator[0] = initiator[1] = initiator[2] = 1;
+			randomKroneckerGraph(G, initiator, 4, 10);
+			AssertThat(G.numberOfNodes(), Equals(0));
+		});
+	});
+});
@@ -0,0 +1,398 @@
+/** \file
+ * \brief Declaration of DynamicGeometricGraph, a random geometric graph
+ * whose points can be inserted, removed and moved.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+
+#include "../common/Parallel.h"
+#include "../common/Random.h"
+
+namespace ogdf {
+
+//! Geometric graph that keeps its edges up to date while its points change.
+/**
+ * Two nodes are adjacent if and only if the Euclidean distance of their
+ * points is at most the radius; on the torus, the distance wraps around
+ * the unit cube. The points are kept in a spatial hash of cells whose
+ * sides are at least the radius, so all neighbors of a point lie in the
+ * 3^d cells around its own. Inserting, removing or moving a node thus only
+ * looks at the points of these cells and changes only the edges incident
+ * to it, which takes time linear in its local degree for points of bounded
+ * density.
+ *
+ * apply() performs a batch of updates. It changes the nodes and the hash
+ * first, then computes the edge changes of all affected nodes in parallel,
+ * on up to generatorThreads() threads, and finally applies them to the
+ * graph, which is not thread-safe.
+ *
+ * The graph is owned by the caller and must only be changed through this
+ * object while it is in use.
+ *
+ * \code
+ * Graph G;
+ * DynamicGeometricGraph dynamic(G, 2, 0.05);
+ * node v = dynamic.insert({0.5, 0.5});
+ * dynamic.move(v, {0.52, 0.5});
+ * dynamic.remove(v);
+ * \endcode
+ */
+class DynamicGeometricGraph {
+public:
+	//! Largest supported dimension.
+	static constexpr int maxDimension = 8;
+
+	//! An update of a batch, see apply().
+	struct Update {
+		enum class Kind { Insert, Remove, Move };
+
+		Kind kind;
+		//! The node to be removed or moved; ignored for insertions.
+		node v;
+		//! The new point; ignored for removals.
+		std::vector<double> position;
+	};
+
+private:
+	//! Integer coordinates of a cell of the spatial hash.
+	struct Cell {
+		int32_t c[maxDimension];
+
+		bool operator==(const Cell &other) const {
+			return std::equal(c, c + maxDimension, other.c);
+		}
+	};
+
+	struct CellHash {
+		size_t operator()(const Cell &cell) const {
+			uint64_t hash = 0;
+			for (int i = 0; i < maxDimension; i++) {
+				hash = splitMix64(hash ^ (uint32_t)cell.c[i]);
+			}
+			return (size_t)hash;
+		}
+	};
+
+	//! Changes of the edges incident to an affected node, see apply().
+	struct EdgeChanges {
+		std::vector<node> added;
+		std::vector<edge> removed;
+	};
+
+	Graph &m_G;
+	int m_dimension;
+	double m_radius;
+	bool m_torus;
+	//! Number of cells per dimension on the torus.
+	int m_cellsPerSide;
+
+	//! Records of the points in every nonempty cell.
+	std::unordered_map<Cell, std::vector<int>, CellHash> m_cells;
+	//! Record of every node; records are kept dense, so memory only depends on the number of nodes.
+	std::unordered_map<node, int> m_record;
+	//! Node, point, cell and position within the cell of every record.
+	std::vector<node> m_node;
+	std::vector<double> m_position;
+	std::vector<Cell> m_cellOf;
+	std::vector<int> m_slot;
+
+	int record(node v) const {
+		auto it = m_record.find(v);
+		OGDF_ASSERT(it != m_record.end());
+		return it->second;
+	}
+
+	const double *point(int r) const {
+		return m_position.data() + (size_t)r * m_dimension;
+	}
+
+	Cell cellOf(const double *p) const {
+		Cell cell = {};
+		for (int i = 0; i < m_dimension; i++) {
+			if (m_torus) {
+				cell.c[i] = std::min((int)(p[i] * m_cellsPerSide), m_cellsPerSide - 1);
+			} else {
+				cell.c[i] = (int32_t)std::floor(p[i] / m_radius);
+			}
+		}
+		return cell;
+	}
+
+	double squaredDistance(const double *p, const double *q) const {
+		double sum = 0.0;
+		for (int i = 0; i < m_dimension; i++) {
+			double delta = std::fabs(p[i] - q[i]);
+			if (m_torus) {
+				delta = std::min(delta, 1.0 - delta);
+			}
+			sum += delta * delta;
+		}
+		return sum;
+	}
+
+	//! Calls \p f(w) for every node w other than that of record \p r whose point is at most the radius away.
+	template<typename F>
+	void forEachNeighbor(int r, F f) const {
+		const double *p = point(r);
+		const Cell &home = m_cellOf[r];
+		double squaredRadius = m_radius * m_radius;
+
+		int offsets = 1;
+		for (int i = 0; i < m_dimension; i++) {
+			offsets *= 3;
+		}
+
+		// on a torus with fewer than three cells per side, several offsets denote the same cell
+		bool deduplicate = m_torus && m_cellsPerSide < 3;
+		std::vector<Cell> visited;
+
+		for (int o = 0; o < offsets; o++) {
+			Cell cell = home;
+			for (int i = 0, rest = o; i < m_dimension; i++, rest /= 3) {
+				cell.c[i] += rest % 3 - 1;
+				if (m_torus) {
+					cell.c[i] = (cell.c[i] + m_cellsPerSide) % m_cellsPerSide;
+				}
+			}
+			if (deduplicate) {
+				if (std::find(visited.begin(), visited.end(), cell) != visited.end()) {
+					continue;
+				}
+				visited.push_back(cell);
+			}
+
+			auto it = m_cells.find(cell);
+			if (it == m_cells.end()) {
+				continue;
+			}
+			for (int s : it->second) {
+				if (s != r && squaredDistance(p, point(s)) <= squaredRadius) {
+					f(m_node[s]);
+				}
+			}
+		}
+	}
+
+	//! Appends a record for the new node \p v and returns it.
+	int addRecord(node v) {
+		int r = (int)m_node.size();
+		m_record[v] = r;
+		m_node.push_back(v);
+		m_position.resize(m_position.size() + m_dimension);
+		m_cellOf.emplace_back();
+		m_slot.push_back(-1);
+		return r;
+	}
+
+	//! Removes record \p r, which is in no cell, by moving the last record into its place.
+	void removeRecord(int r) {
+		int last = (int)m_node.size() - 1;
+		m_record.erase(m_node[r]);
+		if (r != last) {
+			m_node[r] = m_node[last];
+			std::copy(point(last), point(last) + m_dimension, m_position.begin() + (size_t)r * m_dimension);
+			m_cellOf[r] = m_cellOf[last];
+			m_slot[r] = m_slot[last];
+			m_cells.find(m_cellOf[r])->second[m_slot[r]] = r;
+			m_record[m_node[r]] = r;
+		}
+		m_node.pop_back();
+		m_position.resize((size_t)last * m_dimension);
+		m_cellOf.pop_back();
+		m_slot.pop_back();
+	}
+
+	void setPosition(int r, const std::vector<double> &position) {
+		OGDF_ASSERT((int)position.size() == m_dimension);
+		for (int i = 0; i < m_dimension; i++) {
+			double x = position[i];
+			if (m_torus) {
+				x -= std::floor(x);
+			}
+			m_position[(size_t)r * m_dimension + i] = x;
+		}
+	}
+
+	void addToCell(int r) {
+		Cell cell = cellOf(point(r));
+		std::vector<int> &members = m_cells[cell];
+		m_cellOf[r] = cell;
+		m_slot[r] = (int)members.size();
+		members.push_back(r);
+	}
+
+	void removeFromCell(int r) {
+		auto it = m_cells.find(m_cellOf[r]);
+		std::vector<int> &members = it->second;
+		int last = members.back();
+		members[m_slot[r]] = last;
+		m_slot[last] = m_slot[r];
+		members.pop_back();
+		m_slot[r] = -1;
+		if (members.empty()) {
+			m_cells.erase(it);
+		}
+	}
+
+	//! Computes the edge changes of \p v after the points of all nodes in \p affected have been updated.
+	/**
+	 * \p affected is sorted by node index. An edge between two affected
+	 * nodes is only reported by the one with the smaller index, so that it
+	 * is not changed twice. If \p affected is nullptr, \p v is the only
+	 * affected node.
+	 */
+	void computeChanges(node v, const std::vector<node> *affected, EdgeChanges &changes) const {
+		int r = record(v);
+		double squaredRadius = m_radius * m_radius;
+		auto reports = [&](node w) {
+			return affected == nullptr || v->index() < w->index()
+				|| !std::binary_search(affected->begin(), affected->end(), w, byIndex);
+		};
+
+		std::vector<int> adjacent;
+		for (adjEntry adj : v->adjEntries) {
+			node w = adj->twinNode();
+			adjacent.push_back(w->index());
+			if (squaredDistance(point(r), point(record(w))) > squaredRadius && reports(w)) {
+				changes.removed.push_back(adj->theEdge());
+			}
+		}
+		std::sort(adjacent.begin(), adjacent.end());
+
+		forEachNeighbor(r, [&](node w) {
+			if (reports(w) && !std::binary_search(adjacent.begin(), adjacent.end(), w->index())) {
+				changes.added.push_back(w);
+			}
+		});
+	}
+
+	static bool byIndex(node v, node w) {
+		return v->index() < w->index();
+	}
+
+public:
+	//! Creates an empty dynamic geometric graph in \p G.
+	/**
+	 * @param G is cleared and assigned the graph.
+	 * @param dimension is the dimension of the points, at most #maxDimension.
+	 * @param radius is the maximum distance of adjacent points.
+	 * @param torus selects the unit torus instead of Euclidean space.
+	 */
+	DynamicGeometricGraph(Graph &G, int dimension, double radius, bool torus = false)
+		: m_G(G), m_dimension(dimension), m_radius(radius), m_torus(torus),
+		  m_cellsPerSide(std::max(1, (int)std::floor(1.0 / radius))) {
+		OGDF_ASSERT(1 <= dimension && dimension <= maxDimension);
+		OGDF_ASSERT(radius > 0);
+		m_G.clear();
+	}
+
+	DynamicGeometricGraph(const DynamicGeometricGraph &) = delete;
+	DynamicGeometricGraph &operator=(const DynamicGeometricGraph &) = delete;
+
+	//! Returns the graph.
+	const Graph &graph() const { return m_G; }
+
+	//! Returns the coordinates of the point of \p v.
+	std::vector<double> position(node v) const {
+		const double *p = point(record(v));
+		return std::vector<double>(p, p + m_dimension);
+	}
+
+	//! Adds a node at \p position and connects it to its neighbors.
+	node insert(const std::vector<double> &position) {
+		node v = m_G.newNode();
+		int r = addRecord(v);
+		setPosition(r, position);
+		addToCell(r);
+		forEachNeighbor(r, [&](node w) { m_G.newEdge(v, w); });
+		return v;
+	}
+
+	//! Removes \p v and its edges.
+	void remove(node v) {
+		int r = record(v);
+		removeFromCell(r);
+		removeRecord(r);
+		m_G.delNode(v);
+	}
+
+	//! Moves \p v to \p position, removing the edges that became too long and adding the new ones.
+	void move(node v, const std::vector<double> &position) {
+		int r = record(v);
+		removeFromCell(r);
+		setPosition(r, position);
+		addToCell(r);
+
+		EdgeChanges changes;
+		computeChanges(v, nullptr, changes);
+		for (edge e : changes.removed) {
+			m_G.delEdge(e);
+		}
+		for (node w : changes.added) {
+			m_G.newEdge(v, w);
+		}
+	}
+
+	//! Performs \p updates, in which every node occurs at most once, and returns the inserted nodes in order.
+	std::vector<node> apply(const std::vector<Update> &updates) {
+		std::vector<node> inserted, moved;
+
+		// nodes and points
+		for (const Update &update : updates) {
+			switch (update.kind) {
+			case Update::Kind::Insert: {
+				inserted.push_back(m_G.newNode());
+				int r = addRecord(inserted.back());
+				setPosition(r, update.position);
+				addToCell(r);
+				moved.push_back(inserted.back());
+				break;
+			}
+			case Update::Kind::Remove:
+				remove(update.v);
+				break;
+			case Update::Kind::Move: {
+				int r = record(update.v);
+				removeFromCell(r);
+				setPosition(r, update.position);
+				addToCell(r);
+				moved.push_back(update.v);
+				break;
+			}
+			}
+		}
+
+		// as large as the batch, not as the graph
+		std::vector<node> affected(moved);
+		std::sort(affected.begin(), affected.end(), byIndex);
+
+		// edge changes, only reading the graph and the hash
+		std::vector<EdgeChanges> changes(moved.size());
+		parallelFor(moved.size(), parallelChunks(moved.size(), 64), [&](int, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				computeChanges(moved[i], &affected, changes[i]);
+			}
+		});
+
+		for (size_t i = 0; i < moved.size(); i++) {
+			for (edge e : changes[i].removed) {
+				m_G.delEdge(e);
+			}
+			for (node w : changes[i].added) {
+				m_G.newEdge(moved[i], w);
+			}
+		}
+
+		return inserted;
+	}
+};
+
+}
@@ -20,104 +20,207 @@
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/geometry.h>
 
-using std::minstd_rand;
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Random.h"
+#include "../common/ScratchArena.h"
+#include "../common/Shard.h"
+#include "../common/SpaceFillingCurve.h"
+
 using std::uniform_int_distribution;
 using std::uniform_real_distribution;
 using namespace ogdf;
 
 //! Creates a Random Geometeric Graph by laying out nodes in a unit n-cube.
 /**
- * @param G is assigned the generated graph.
+ * @param sink is assigned the generated graph.
  * @param n is the number of nodes of the generated graph.
  * @param threshold is threshold radius.
  * @dimension is the dimension of n-cube.
+ * @param order is the order in which the points are numbered.
  */
-void randomGeometricCubeGraph(Graph &G, int n, double threshold, int dimension=2) {
+void randomGeometricCubeGraph(EdgeSink &sink, int n, double threshold, int dimension, NodeOrder order) {
 	OGDF_ASSERT(dimension >= 2);
 	
-	G.clear();
-	if (n == 0) return;
+	if (n == 0) {
+		sink.finish();
+		return;
+	}
 
-	minstd_rand rng(randomSeed());
+	GeneratorProbe probe;
+	RandomEngine rng(generatorSeed());
 	uniform_real_distribution<> dist(0, 1);
 
-	NodeArray<Array<double>> cord(G, Array<double>(dimension));
+	// coordinates of node i are cord[i*dimension] ... cord[i*dimension + dimension-1]
+	ScratchFrame scratch;
+	double *cord = scratch.allocate<double>((size_t)n * dimension);
 
 	// adding n nodes to graph
+	sink.reserve(n, 0);
 	for (int i = 0; i < n; i++) {
-		G.newNode();
+		sink.addNode();
 	}
 
 	// setting random points in the n-cube
-	for (node v : G.nodes) {
+	for (int v = 0; v < n; v++) {
 		for (int i = 0; i < dimension; i++){
-			cord[v][i] = dist(rng);
+			cord[v*dimension + i] = dist(rng);
 		}
 	}
 
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
+	// numbering the points along a space-filling curve
+	if (order != NodeOrder::Random) {
+		applyCurveOrder(cord, dimension, curveOrder(n, dimension, order, [&](int v, int i) { return cord[v*dimension + i]; }));
+	}
+
+	// reporting the positions of the nodes
+	for (int v = 0; v < n; v++) {
+		sink.setPosition(v, cord + (size_t)v * dimension, dimension);
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	for (int v = rows.first; v < rows.second; v++) {
+		probe.pairs(n - v - 1);
+		for (int w = v + 1; w < n; w++) {
 			double distance = 0.0;
 			for (int i = 0; i < dimension; i++) {
-				distance += (cord[v][i] - cord[w][i])*(cord[v][i] - cord[w][i]);
+				double delta = cord[v*dimension + i] - cord[w*dimension + i];
+				distance += delta*delta;
 			}
 			distance = sqrt(distance);
-			distance *= threshold;
-			if (distance < (threshold + std::numeric_limits<double>::epsilon())) {
-				G.newEdge(v, w);
+			if (distance <= threshold) {
+				sink.addEdge(v, w, distance);
+				probe.edges();
 			}
 		}
 	}
 
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
 }
 
+//! Creates a Random Geometeric Graph by laying out nodes in a unit n-cube.
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param threshold is threshold radius.
+ * @dimension is the dimension of n-cube.
+ * @param order is the order in which the points are numbered.
+ */
+void randomGeometricCubeGraph(Graph &G, int n, double threshold, int dimension, NodeOrder order) {
+	G.clear();
+	GraphSink sink(G);
+	randomGeometricCubeGraph(sink, n, threshold, dimension, order);
+}
 
-//! Creates a Random Geometeric Graph by laying out nodes in a torus.
+//! Creates a Random Geometeric Graph by laying out nodes in a unit n-cube and assigns positions and edge lengths.
 /**
  * @param G is assigned the generated graph.
+ * @param GA is assigned the positions of the nodes, of which x, y and z are the first three coordinates; it must belong to \p G.
+ * @param distance is assigned the distance between the endpoints of each edge.
  * @param n is the number of nodes of the generated graph.
  * @param threshold is threshold radius.
+ * @dimension is the dimension of n-cube.
+ * @param order is the order in which the points are numbered.
  */
-void randomGeometricTorusGraph(Graph &G, int n, double threshold) {
+void randomGeometricCubeGraph(Graph &G, GraphAttributes &GA, EdgeArray<double> &distance, int n, double threshold, int dimension, NodeOrder order) {
 	G.clear();
-	if (n == 0) return;
+	GraphSink sink(G, &distance, &GA);
+	randomGeometricCubeGraph(sink, n, threshold, dimension, order);
+}
+
 
-	minstd_rand rng(randomSeed());
+//! Creates a Random Geometeric Graph by laying out nodes in a torus.
+/**
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param threshold is threshold radius.
+ */
+void randomGeometricTorusGraph(EdgeSink &sink, int n, double threshold) {
+	if (n == 0) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	RandomEngine rng(generatorSeed());
 	uniform_real_distribution<> dist(0, 1);
-	NodeArray <double> cordx(G, 0.0);
-	NodeArray <double> cordy(G, 0.0);
+	ScratchFrame scratch;
+	double *cordx = scratch.allocate<double>(n);
+	double *cordy = scratch.allocate<double>(n);
 
 	// adding n nodes to graph
+	sink.reserve(n, 0);
 	for (int i = 0; i < n; i++) {
-		G.newNode();
+		sink.addNode();
 	}
 
 	// setting random points in the torus
-	for (node v : G.nodes) {
+	for (int v = 0; v < n; v++) {
 		cordx[v] = dist(rng);
 		cordy[v] = dist(rng);
 	}
 
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
-			double dx = std::min(abs(cordx[v] - cordx[w]), 1 - abs(cordx[v] - cordx[w]));
-			double dy = std::min(abs(cordy[v] - cordy[w]), 1 - abs(cordy[v] - cordy[w]));
+	// reporting the positions of the nodes
+	for (int v = 0; v < n; v++) {
+		double position[2] = {cordx[v], cordy[v]};
+		sink.setPosition(v, position, 2);
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	for (int v = rows.first; v < rows.second; v++) {
+		probe.pairs(n - v - 1);
+		for (int w = v + 1; w < n; w++) {
+			double dx = std::min(fabs(cordx[v] - cordx[w]), 1 - fabs(cordx[v] - cordx[w]));
+			double dy = std::min(fabs(cordy[v] - cordy[w]), 1 - fabs(cordy[v] - cordy[w]));
 			double distance = sqrt(dx*dx + dy*dy);
-			distance *= threshold;
-			if (distance < (threshold / 2 + std::numeric_limits<double>::epsilon())) {
-				G.newEdge(v, w);
+			if (distance <= threshold) {
+				sink.addEdge(v, w, distance);
+				probe.edges();
 			}
 		}
 	}
 
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Random Geometeric Graph by laying out nodes in a torus.
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param threshold is threshold radius.
+ */
+void randomGeometricTorusGraph(Graph &G, int n, double threshold) {
+	G.clear();
+	GraphSink sink(G);
+	randomGeometricTorusGraph(sink, n, threshold);
+}
+
+//! Creates a Random Geometeric Graph by laying out nodes in a torus and assigns positions and edge lengths.
+/**
+ * @param G is assigned the generated graph.
+ * @param GA is assigned the positions of the nodes; it must belong to \p G.
+ * @param distance is assigned the distance on the torus between the endpoints of each edge.
+ * @param n is the number of nodes of the generated graph.
+ * @param threshold is threshold radius.
+ */
+void randomGeometricTorusGraph(Graph &G, GraphAttributes &GA, EdgeArray<double> &distance, int n, double threshold) {
+	G.clear();
+	GraphSink sink(G, &distance, &GA);
+	randomGeometricTorusGraph(sink, n, threshold);
 }
 
+#ifndef OGDF_GENERATORS_LIBRARY
 int main(){
 	//! TODO: tests
 	Graph G;
-	randomGeometricCubeGraph(G, 100, 10);
-	randomGeometricCubeGraph(G, 100, 10, 4);
-	randomGeometricTorusGraph(G, 100, 10);
+	randomGeometricCubeGraph(G, 100, 0.2);
+	randomGeometricCubeGraph(G, 100, 0.5, 4);
+	randomGeometricTorusGraph(G, 100, 0.2);
 
 	return 0;
 }
+#endif
@@ -0,0 +1,330 @@
+#include "bandit/bandit.h"
+#include "ogdf/basic/Graph.h"
+#include "ogdf/basic/GraphAttributes.h"
+
+#include "../common/Ensemble.h"
+#include "../common/Generators.h"
+#include "../common/Parallel.h"
+#include "../common/Random.h"
+#include "../common/SpaceFillingCurve.h"
+#include "DynamicGeometricGraph.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+//! Returns true if the edges of the dynamic graph are exactly the pairs of points at most \p radius apart.
+static bool matchesPoints(const DynamicGeometricGraph &dynamic, int dimension, double radius, bool torus) {
+	const Graph &G = dynamic.graph();
+	std::vector<std::pair<int, int>> expected, actual;
+	for (node v : G.nodes) {
+		for (node w : G.nodes) {
+			if (v->index() >= w->index()) continue;
+			std::vector<double> p = dynamic.position(v), q = dynamic.position(w);
+			double distance = 0;
+			for (int i = 0; i < dimension; i++) {
+				double delta = fabs(p[i] - q[i]);
+				if (torus) delta = std::min(delta, 1.0 - delta);
+				distance += delta * delta;
+			}
+			if (distance <= radius * radius) {
+				expected.emplace_back(v->index(), w->index());
+			}
+		}
+	}
+	for (edge e : G.edges) {
+		actual.emplace_back(std::min(e->source()->index(), e->target()->index()),
+			std::max(e->source()->index(), e->target()->index()));
+	}
+	std::sort(expected.begin(), expected.end());
+	std::sort(actual.begin(), actual.end());
+	return expected == actual;
+}
+
+static void describeDynamicGraph(int dimension, double radius, bool torus) {
+	std::string name = std::to_string(dimension) + "-dimensional " + (torus ? "torus" : "cube")
+		+ " with radius " + std::to_string(radius);
+
+	describe(name.c_str(), [&](){
+		CounterStream random(dimension, torus, 0);
+		auto randomPoint = [&]() {
+			std::vector<double> p(dimension);
+			for (double &x : p) x = random.uniform();
+			return p;
+		};
+
+		it("keeps the edges up to date under single updates", [&](){
+			Graph G;
+			DynamicGeometricGraph dynamic(G, dimension, radius, torus);
+			std::vector<node> nodes;
+			for (int step = 0; step < 300; step++) {
+				int action = nodes.size() < 20 ? 0 : (int)(random() % 3);
+				if (action == 0) {
+					nodes.push_back(dynamic.insert(randomPoint()));
+				} else {
+					size_t i = random() % nodes.size();
+					if (action == 1) {
+						dynamic.remove(nodes[i]);
+						nodes[i] = nodes.back();
+						nodes.pop_back();
+					} else {
+						dynamic.move(nodes[i], randomPoint());
+					}
+				}
+			}
+			AssertThat(matchesPoints(dynamic, dimension, radius, torus), IsTrue());
+		});
+
+		it("keeps the points and edges up to date while nodes are replaced", [&](){
+			Graph G;
+			DynamicGeometricGraph dynamic(G, dimension, radius, torus);
+			std::vector<node> nodes;
+			std::vector<std::vector<double>> points;
+			for (int i = 0; i < 40; i++) {
+				points.push_back(randomPoint());
+				nodes.push_back(dynamic.insert(points.back()));
+			}
+			for (int step = 0; step < 2000; step++) {
+				size_t i = random() % nodes.size();
+				dynamic.remove(nodes[i]);
+				points[i] = randomPoint();
+				nodes[i] = dynamic.insert(points[i]);
+				if (step % 2 == 0) {
+					size_t j = random() % nodes.size();
+					points[j] = randomPoint();
+					dynamic.move(nodes[j], points[j]);
+				}
+			}
+			AssertThat(G.numberOfNodes(), Equals(40));
+			for (size_t i = 0; i < nodes.size(); i++) {
+				AssertThat(dynamic.position(nodes[i]) == points[i], IsTrue());
+			}
+			AssertThat(matchesPoints(dynamic, dimension, radius, torus), IsTrue());
+		});
+
+		it("keeps the edges up to date under batches", [&](){
+			Graph G;
+			DynamicGeometricGraph dynamic(G, dimension, radius, torus);
+			ThreadLimit limit(4);
+			std::vector<node> nodes;
+			for (int batch = 0; batch < 10; batch++) {
+				std::vector<DynamicGeometricGraph::Update> updates;
+				for (int i = 0; i < 100; i++) {
+					updates.push_back({DynamicGeometricGraph::Update::Kind::Insert, nullptr, randomPoint()});
+				}
+				std::vector<node> kept;
+				for (size_t i = 0; i < nodes.size(); i++) {
+					switch (random() % 3) {
+					case 0:
+						updates.push_back({DynamicGeometricGraph::Update::Kind::Remove, nodes[i], {}});
+						break;
+					case 1:
+						updates.push_back({DynamicGeometricGraph::Update::Kind::Move, nodes[i], randomPoint()});
+						kept.push_back(nodes[i]);
+						break;
+					default:
+						kept.push_back(nodes[i]);
+					}
+				}
+				std::vector<node> inserted = dynamic.apply(updates);
+				AssertThat(inserted.size(), Equals((size_t)100));
+				nodes = kept;
+				nodes.insert(nodes.end(), inserted.begin(), inserted.end());
+				AssertThat(matchesPoints(dynamic, dimension, radius, torus), IsTrue());
+			}
+			AssertThat(G.numberOfNodes(), Equals((int)nodes.size()));
+		});
+	});
+}
+
+//! Returns the sorted degrees and the median index difference of the endpoints of the edges that \p generate writes.
+static std::pair<std::vector<int>, uint32_t> graphShape(int n, const Ensemble::Model &generate) {
+	Ensemble::Edges edges;
+	EdgeListSink sink(edges);
+	SeedScope scope(n);
+	generate(sink);
+
+	std::vector<int> degree(n, 0);
+	std::vector<uint32_t> span;
+	for (const auto &e : edges) {
+		degree[e.first]++;
+		degree[e.second]++;
+		span.push_back(e.second - e.first);
+	}
+	std::sort(degree.begin(), degree.end());
+	std::nth_element(span.begin(), span.begin() + span.size() / 2, span.end());
+	return {degree, span[span.size() / 2]};
+}
+
+go_bandit([](){
+	describe("randomGeometricCubeGraph", [&](){
+		it("connects all pairs if the threshold is the diameter of the cube", [&](){
+			Graph G;
+			randomGeometricCubeGraph(G, 60, sqrt(2.0));
+			AssertThat(G.numberOfEdges(), Equals(60 * 59 / 2));
+			randomGeometricCubeGraph(G, 60, sqrt(3.0), 3);
+			AssertThat(G.numberOfEdges(), Equals(60 * 59 / 2));
+		});
+
+		it("connects no pairs if the threshold is zero", [&](){
+			Graph G;
+			randomGeometricCubeGraph(G, 60, 0.0);
+			AssertThat(G.numberOfNodes(), Equals(60));
+			AssertThat(G.numberOfEdges(), Equals(0));
+		});
+	});
+
+	describe("randomGeometricTorusGraph", [&](){
+		it("gives a node about (n - 1) pi r^2 neighbors", [&](){
+			for (double threshold : {0.02, 0.05}) {
+				Graph G;
+				randomGeometricTorusGraph(G, 2000, threshold);
+				double expected = 1999 * M_PI * threshold * threshold;
+				double averageDegree = 2.0 * G.numberOfEdges() / G.numberOfNodes();
+				AssertThat(0.1 * expected, IsGreaterThan(fabs(averageDegree - expected)));
+			}
+		});
+
+		it("connects no pairs if the threshold is zero", [&](){
+			Graph G;
+			randomGeometricTorusGraph(G, 60, 0.0);
+			AssertThat(G.numberOfNodes(), Equals(60));
+			AssertThat(G.numberOfEdges(), Equals(0));
+		});
+	});
+
+	describe("curveKey", [&](){
+		it("numbers the cells of the Hilbert curve such that consecutive cells are adjacent", [&](){
+			for (int dimension : {2, 3}) {
+				const int bits = 4;
+				int cells = 1 << (bits * dimension);
+				std::vector<std::vector<uint32_t>> cellAt(cells);
+				for (int c = 0; c < cells; c++) {
+					std::vector<uint32_t> cell(dimension), coordinates(dimension);
+					for (int i = 0; i < dimension; i++) {
+						cell[i] = coordinates[i] = (c >> (bits * i)) & ((1 << bits) - 1);
+					}
+					uint64_t key = curveKey(cell.data(), dimension, bits, NodeOrder::Hilbert);
+					AssertThat(key < (uint64_t)cells && cellAt[key].empty(), IsTrue());
+					cellAt[key] = coordinates;
+				}
+				for (int k = 1; k < cells; k++) {
+					int distance = 0;
+					for (int i = 0; i < dimension; i++) {
+						distance += std::abs((int)cellAt[k][i] - (int)cellAt[k - 1][i]);
+					}
+					AssertThat(distance, Equals(1));
+				}
+			}
+		});
+
+		it("interleaves the bits for the Morton curve", [&](){
+			uint32_t cell[2] = {0x5, 0x3};
+			AssertThat(curveKey(cell, 2, 3, NodeOrder::Morton), Equals(0x27u));
+		});
+	});
+
+	describe("node orders", [&](){
+		it("give randomGeometricCubeGraph the same graph up to numbering", [&](){
+			for (int dimension : {2, 3}) {
+				auto generate = [dimension](NodeOrder order) {
+					return [=](EdgeSink &sink) { randomGeometricCubeGraph(sink, 300, 0.5, dimension, order); };
+				};
+				auto random = graphShape(300, generate(NodeOrder::Random));
+				for (NodeOrder order : {NodeOrder::Morton, NodeOrder::Hilbert}) {
+					AssertThat(graphShape(300, generate(order)).first == random.first, IsTrue());
+				}
+			}
+		});
+
+		it("give randomGeographicalThresholdGraph the same graph with nearby endpoints", [&](){
+			for (int dimension : {2, 3}) {
+				auto generate = [dimension](NodeOrder order) {
+					return [=](EdgeSink &sink) { randomGeographicalThresholdGraph(sink, 4000, 2.0, 400.0, 1.0, dimension, order); };
+				};
+				auto random = graphShape(4000, generate(NodeOrder::Random));
+				for (NodeOrder order : {NodeOrder::Morton, NodeOrder::Hilbert}) {
+					auto sorted = graphShape(4000, generate(order));
+					AssertThat(sorted.first == random.first, IsTrue());
+					AssertThat(sorted.second * 10 < random.second, IsTrue());
+				}
+			}
+		});
+	});
+
+	describe("positions and distances", [&](){
+		it("connect exactly the points at most the threshold apart", [&](){
+			for (bool torus : {false, true}) {
+				Graph G;
+				GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::threeD);
+				EdgeArray<double> distance;
+				if (torus) {
+					randomGeometricTorusGraph(G, GA, distance, 300, 0.1);
+				} else {
+					randomGeometricCubeGraph(G, GA, distance, 300, 0.2, 3);
+				}
+
+				std::vector<std::pair<int, int>> expected, actual;
+				for (node v : G.nodes) {
+					for (node w : G.nodes) {
+						if (v->index() >= w->index()) continue;
+						double delta[3] = {GA.x(v) - GA.x(w), GA.y(v) - GA.y(w), torus ? 0.0 : GA.z(v) - GA.z(w)};
+						double squared = 0;
+						for (double d : delta) {
+							d = std::fabs(d);
+							if (torus) d = std::min(d, 1.0 - d);
+							squared += d * d;
+						}
+						if (std::sqrt(squared) <= (torus ? 0.1 : 0.2)) {
+							expected.emplace_back(v->index(), w->index());
+						}
+					}
+				}
+				for (edge e : G.edges) {
+					actual.emplace_back(std::min(e->source()->index(), e->target()->index()),
+						std::max(e->source()->index(), e->target()->index()));
+				}
+				std::sort(expected.begin(), expected.end());
+				std::sort(actual.begin(), actual.end());
+				AssertThat(actual.empty(), IsFalse());
+				AssertThat(actual == expected, IsTrue());
+			}
+		});
+
+		it("are assigned consistently by randomGeometricCubeGraph in three dimensions", [&](){
+			Graph G;
+			GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::threeD);
+			EdgeArray<double> distance;
+			randomGeometricCubeGraph(G, GA, distance, 200, 0.5, 3, NodeOrder::Hilbert);
+			AssertThat(G.numberOfEdges(), IsGreaterThan(0));
+			for (edge e : G.edges) {
+				node v = e->source(), w = e->target();
+				double dx = GA.x(v) - GA.x(w), dy = GA.y(v) - GA.y(w), dz = GA.z(v) - GA.z(w);
+				AssertThat(std::fabs(distance[e] - std::sqrt(dx * dx + dy * dy + dz * dz)) < 1e-12, IsTrue());
+			}
+		});
+
+		it("are assigned consistently by randomGeographicalThresholdGraph", [&](){
+			Graph G;
+			GraphAttributes GA(G, GraphAttributes::nodeGraphics);
+			EdgeArray<double> distance;
+			randomGeographicalThresholdGraph(G, GA, distance, 300, 2.0, 30.0);
+			AssertThat(G.numberOfEdges(), IsGreaterThan(0));
+			for (edge e : G.edges) {
+				node v = e->source(), w = e->target();
+				double dx = GA.x(v) - GA.x(w), dy = GA.y(v) - GA.y(w);
+				AssertThat(std::fabs(distance[e] - std::sqrt(dx * dx + dy * dy)) < 1e-12, IsTrue());
+			}
+		});
+	});
+
+	describe("DynamicGeometricGraph", [&](){
+		describeDynamicGraph(2, 0.1, false);
+		describeDynamicGraph(2, 0.1, true);
+		describeDynamicGraph(3, 0.2, false);
+		describeDynamicGraph(3, 0.45, true);
+		// two and one cells per side of the torus
+		describeDynamicGraph(2, 0.4, true);
+		describeDynamicGraph(2, 0.6, true);
+		describeDynamicGraph(1, 0.05, true);
+	});
+});
@@ -20,7 +20,6 @@
 #include <iostream>
 #include <cmath>
 #include <random>
-#include <cstdlib>
 #include <algorithm>
 
 #include <ogdf/basic/Graph.h> 
@@ -29,37 +28,35 @@
 #include <ogdf/basic/graph_generators.h>
 #include <ogdf/basic/simple_graph_alg.h>
 
-using std::minstd_rand;
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Random.h"
+#include "../common/ScratchArena.h"
+
 using std::uniform_int_distribution;
 using std::uniform_real_distribution;
 using namespace ogdf;
 
-//! Creates a Random Regular Graph. 
+//! Pairs the points of the buckets randomly.
 /**
- * @param G is assigned the generated graph.
  * @param n is the number of nodes 
  * @param k is number of points in each bucket.
+ * @param ends is assigned the buckets of the 2e-th and (2e+1)-th point of the e-th pair.
+ * @param rng is the random engine of the generator.
+ * @param probe records the statistics of the calling generator.
+ * @return true if the resulting graph is simple.
  */
-void randomRegularGraphI(Graph &G, int n, int k) {
-	OGDF_ASSERT(n >= 0);
-	OGDF_ASSERT(n*k % 2 == 0);
-
-	G.clear();
-
-	Array<node> vis(n);
-
-	for (int i = 0; i < n; i++) {
-		vis[i] = G.newNode();
-	}
-
-	Array<int> nodeMapper(n*k);
-	Array<bool> paired(n*k);
+static bool randomRegularGraphI(int n, int k, int *ends, RandomEngine &rng, GeneratorProbe &probe) {
+	ScratchFrame scratch;
+	int *nodeMapper = scratch.allocate<int>(n*k);
+	bool *paired = scratch.allocate<bool>(n*k);
 
 	for (int points = 0; points < n*k; points++) {
 		nodeMapper[points] = (int)floor(points / k);
 		paired[points] = false;
 	}
 
+	int pairs = 0;
 	for (int i = 0; i < n*k;) {
 		int u, v;
 		u = nodeMapper[i];
@@ -72,29 +69,87 @@ void randomRegularGraphI(Graph &G, int n, int k) {
 
 		if (!(i < n*k)) break;
 
-		int value = (rand() % (n*k - i + 1)) + i;
+		//! pairing i with one of the points after it
+		uniform_int_distribution<> choosePoint(i + 1, n*k - 1);
+		int value = choosePoint(rng);
 
 		v = nodeMapper[value];
 		while (paired[value]) {
-			value = (rand() % (n*k - i + 1)) + i;
+			probe.rejections();
+			value = choosePoint(rng);
 			v = nodeMapper[value];
 		}
 
 		paired[i] = true;
 		paired[value] = true;
 
-		G.newEdge(vis[u], vis[v]);
+		ends[2 * pairs] = u;
+		ends[2 * pairs + 1] = v;
+		pairs++;
+	}
+	probe.pairs(pairs);
+
+	//! checking for loops and multiple edges
+	long long *keys = scratch.allocate<long long>(pairs);
+	for (int e = 0; e < pairs; e++) {
+		int u = ends[2 * e], v = ends[2 * e + 1];
+		if (u == v) return false;
+		keys[e] = (long long)std::min(u, v) * n + std::max(u, v);
 	}
+	std::sort(keys, keys + pairs);
+
+	return std::adjacent_find(keys, keys + pairs) == keys + pairs;
 }
 
-void randomRegularGraph(Graph &G, int n, int k) {
+//! Creates a Random Regular Graph. 
+/**
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes 
+ * @param k is number of points in each bucket.
+ */
+void randomRegularGraph(EdgeSink &sink, int n, int k) {
+	OGDF_ASSERT(n >= 0);
+	OGDF_ASSERT(n*k % 2 == 0);
+
+	GeneratorProbe probe;
+	RandomEngine rng(generatorSeed());
+	ScratchFrame scratch;
+	int *ends = scratch.allocate<int>(n*k);
+
 	//! Due to point 5 in algorithm this might take forever :P
-	do {
-		randomRegularGraphI(G, n, k);
-	} while (!isSimple(G));
+	probe.phase(GeneratorStats::Phase::Edges);
+	while (!randomRegularGraphI(n, k, ends, rng, probe)) {
+		probe.restarts();
+	}
+
+	sink.reserve(n, (long long)n*k / 2);
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
+	}
+
+	for (int e = 0; e < n*k / 2; e++) {
+		sink.addEdge(ends[2 * e], ends[2 * e + 1]);
+	}
+	probe.edges(n*k / 2);
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Random Regular Graph. 
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes 
+ * @param k is number of points in each bucket.
+ */
+void randomRegularGraph(Graph &G, int n, int k) {
+	G.clear();
+	GraphSink sink(G);
+	randomRegularGraph(sink, n, k);
 }
 
 
+#ifndef OGDF_GENERATORS_LIBRARY
 int main(){
 
 	//! TODO: tests
@@ -104,3 +159,4 @@ int main(){
 	
 	return 0;
 }
+#endif
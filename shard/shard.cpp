@@ -0,0 +1,180 @@
+/** \file
+ * \brief Generates a graph as shards in local processes.
+ *
+ * Every shard is produced by generateShard() of common/Shard.h in a child
+ * process of its own and written to the binary edge list file
+ * <output>.<index>.edges, so that the shards together hold the edges of the
+ * graph the generator produces with the seed in a single process. With
+ * --shard, only that shard is generated, in the calling process, as a job on
+ * a cluster would.
+ *
+ * Usage: generators-shard --generator name --n 100000 [--seed 1]
+ *   [--shards 4] [--shard index] [--output graph]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../common/EdgeListFile.h"
+#include "../common/Generators.h"
+#include "../common/Shard.h"
+
+using namespace ogdf;
+
+namespace {
+
+//! A generator that supports shards and the parameters it is run with, which give sparse graphs for every n.
+struct Generator {
+	const char *name;
+	std::function<void(EdgeSink &, int)> run;
+};
+
+Array<int> constantWeights(int n, int weight) {
+	Array<int> weights(n);
+	for (int &w : weights) {
+		w = weight;
+	}
+	return weights;
+}
+
+std::vector<Generator> generators() {
+	// Waxman parameters giving an average degree of roughly 10
+	auto planeAlpha = [](int n) { return std::min(1.0, 80.0 / n); };
+	auto modelTwoAlpha = [](int n) { return std::min(1.0, 100.0 / n); };
+	// a geometric threshold giving an average degree of 10, as pi r^2 n = 10
+	auto geometricThreshold = [](int n) { return std::sqrt(10.0 / (M_PI * std::max(n, 1))); };
+
+	return {
+		{ "randomChungLuGraph", [](EdgeSink &sink, int n) { randomChungLuGraph(sink, constantWeights(n, 10)); } },
+		{ "randomChungLuRandomWeightsGraph", [](EdgeSink &sink, int n) { randomChungLuRandomWeightsGraph(sink, n); } },
+		{ "norrosReittuGraph", [](EdgeSink &sink, int n) { norrosReittuGraph(sink, constantWeights(n, 10)); } },
+		{ "norrosReittuRandomWeightsGraph", [](EdgeSink &sink, int n) { norrosReittuRandomWeightsGraph(sink, n); } },
+		{ "randomGeographicalThresholdGraph", [](EdgeSink &sink, int n) { randomGeographicalThresholdGraph(sink, n, 2.0, n / 10.0); } },
+		{ "randomGeographicalThresholdWeightsGraph", [](EdgeSink &sink, int n) { randomGeographicalThresholdWeightsGraph(sink, constantWeights(n, 1), 2.0, n / 5.0); } },
+		{ "randomGeometricCubeGraph", [=](EdgeSink &sink, int n) { randomGeometricCubeGraph(sink, n, geometricThreshold(n)); } },
+		{ "randomGeometricTorusGraph", [=](EdgeSink &sink, int n) { randomGeometricTorusGraph(sink, n, geometricThreshold(n)); } },
+		{ "randomHyperbolicGraph", [](EdgeSink &sink, int n) { randomHyperbolicGraph(sink, n, 10, 2.5); } },
+		{ "randomWaxmanGraphUsingPlane", [=](EdgeSink &sink, int n) { randomWaxmanGraphUsingPlane(sink, n, planeAlpha(n), 0.1); } },
+		{ "randomWaxmanGraphUsingGrid", [=](EdgeSink &sink, int n) { randomWaxmanGraphUsingGrid(sink, n, planeAlpha(n), 0.1, 100, 100); } },
+		{ "randomWaxmanGraph", [=](EdgeSink &sink, int n) { randomWaxmanGraph(sink, n, modelTwoAlpha(n), 0.1); } },
+		{ "randomWaxmanGraphIntegral", [=](EdgeSink &sink, int n) { randomWaxmanGraphIntegral(sink, n, modelTwoAlpha(n), 0.1, 1000); } },
+	};
+}
+
+struct Options {
+	std::string generator;
+	int n = -1;
+	uint64_t seed = 1;
+	int shards = 4;
+	//! The only shard to generate, or -1 for all of them.
+	int shard = -1;
+	std::string output = "graph";
+};
+
+//! Generates shard \p index of \p generator into its file and returns true on success.
+bool writeShard(const Generator &generator, const Options &options, int index) {
+	std::string path = options.output + "." + std::to_string(index) + ".edges";
+	std::string parameters = "n=" + std::to_string(options.n)
+		+ " shard=" + std::to_string(index) + "/" + std::to_string(options.shards);
+	EdgeListFileSink file(path, generator.name, parameters, options.seed);
+	if (!generateShard(file, options.seed, index, options.shards, generator.name, [&](EdgeSink &sink) { generator.run(sink, options.n); })) {
+		fprintf(stderr, "%s does not support shards\n", generator.name);
+		return false;
+	}
+	if (!file.good()) {
+		perror(path.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool parse(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; i++) {
+		std::string flag = argv[i];
+		if (i + 1 == argc) {
+			return false;
+		}
+		std::string value = argv[++i];
+		if (flag == "--generator") {
+			options.generator = value;
+		} else if (flag == "--n") {
+			options.n = std::atoi(value.c_str());
+		} else if (flag == "--seed") {
+			options.seed = std::strtoull(value.c_str(), nullptr, 10);
+		} else if (flag == "--shards") {
+			options.shards = std::atoi(value.c_str());
+		} else if (flag == "--shard") {
+			options.shard = std::atoi(value.c_str());
+		} else if (flag == "--output") {
+			options.output = value;
+		} else {
+			return false;
+		}
+	}
+	return options.n >= 0 && options.shards > 0 && options.shard < options.shards;
+}
+
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	std::vector<Generator> all = generators();
+	const Generator *generator = nullptr;
+	if (parse(argc, argv, options)) {
+		for (const Generator &g : all) {
+			if (options.generator == g.name) {
+				generator = &g;
+			}
+		}
+	}
+	if (generator == nullptr) {
+		fprintf(stderr, "usage: %s --generator name --n nodes [--seed s] [--shards k] [--shard i] [--output prefix]\n"
+			"generators:", argv[0]);
+		for (const Generator &g : all) {
+			fprintf(stderr, " %s", g.name);
+		}
+		fprintf(stderr, "\n");
+		return 2;
+	}
+
+	if (options.shard >= 0) {
+		return writeShard(*generator, options, options.shard) ? 0 : 1;
+	}
+
+	// one child process per shard, the local stand-in for the jobs of a cluster
+	std::vector<pid_t> children;
+	int failed = 0;
+	for (int index = 0; index < options.shards; index++) {
+		pid_t child = fork();
+		if (child == 0) {
+			_exit(writeShard(*generator, options, index) ? 0 : 1);
+		}
+		if (child < 0) {
+			perror("fork");
+			failed++;
+		} else {
+			children.push_back(child);
+		}
+	}
+
+	for (pid_t child : children) {
+		int status = 0;
+		waitpid(child, &status, 0);
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			failed++;
+		}
+	}
+	if (failed > 0) {
+		fprintf(stderr, "%d of %d shards failed\n", failed, options.shards);
+		return 1;
+	}
+	return 0;
+}
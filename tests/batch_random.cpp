@@ -0,0 +1,112 @@
+#include <cstdint>
+#include <cstring>
+
+#include "bandit/bandit.h"
+
+#include "../common/BatchRandom.h"
+#include "../common/Random.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+//! Scalar xoshiro256++ as published by Blackman and Vigna, the reference for the lanes of BatchRandom.
+class Xoshiro256PlusPlus {
+	uint64_t m_state[4];
+
+	static uint64_t rotl(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+public:
+	explicit Xoshiro256PlusPlus(const uint64_t state[4]) {
+		std::memcpy(m_state, state, sizeof(m_state));
+	}
+
+	uint64_t operator()() {
+		uint64_t *s = m_state;
+		uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+		uint64_t t = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = rotl(s[3], 45);
+		return result;
+	}
+
+	//! Returns the double in [0, 1) formed from the upper 52 bits of the next output.
+	double uniform() {
+		return (double)((*this)() >> 12) * 0x1.0p-52;
+	}
+};
+
+//! Checks that \p random yields the outputs of the reference generators with the states \p lanes in turn.
+static void assertLanes(BatchRandom &random, const uint64_t lanes[4][4]) {
+	Xoshiro256PlusPlus reference[4] = {
+		Xoshiro256PlusPlus(lanes[0]), Xoshiro256PlusPlus(lanes[1]),
+		Xoshiro256PlusPlus(lanes[2]), Xoshiro256PlusPlus(lanes[3])};
+	bool equal = true;
+	for (int i = 0; i < 3 * BatchRandom::blockSize; i++) {
+		equal &= random.next() == reference[i % 4].uniform();
+	}
+	AssertThat(equal, IsTrue());
+}
+
+//! Returns the bits of \p value.
+static uint64_t bitsOf(double value) {
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+go_bandit([](){
+	describe("BatchRandom", [&](){
+		it("builds on the published SplitMix64 and xoshiro256++", [&](){
+			AssertThat(splitMix64(0), Equals(0xe220a8397b1dcdafULL));
+			const uint64_t state[4] = {1, 2, 3, 4};
+			Xoshiro256PlusPlus reference(state);
+			AssertThat(reference(), Equals(41943041ULL));
+		});
+
+		it("interleaves four xoshiro256++ generators seeded by SplitMix64", [&](){
+			for (uint64_t seed : {0ULL, 42ULL, 0xffffffffffffffffULL}) {
+				uint64_t lanes[4][4];
+				for (int l = 0; l < 4; l++) {
+					for (int i = 0; i < 4; i++) {
+						lanes[l][i] = splitMix64(seed + (uint64_t)(4 * l + i) * 0x9e3779b97f4a7c15ULL);
+					}
+				}
+				BatchRandom random(seed);
+				assertLanes(random, lanes);
+			}
+		});
+
+		it("interleaves four xoshiro256++ generators seeded by a counter stream", [&](){
+			uint64_t lanes[4][4];
+			CounterStream counter(7, 1, 12345);
+			for (int l = 0; l < 4; l++) {
+				for (int i = 0; i < 4; i++) {
+					lanes[l][i] = counter();
+				}
+			}
+			BatchRandom random(7, 1, 12345);
+			assertLanes(random, lanes);
+		});
+
+		it("draws the known answers with and without AVX2", [&](){
+			// the first four draws and the first two of the second block for seed 42, as bits
+			const uint64_t expected[6] = {
+				0x3fea0ec9a9e88eccULL, 0x3fc70ee5c1f7d9b8ULL, 0x3fe335bc4bcaa502ULL, 0x3fe55a8958dd7340ULL,
+				0x3feed419c98b07e8ULL, 0x3fe27a44b305a0f2ULL};
+			BatchRandom random(42);
+			bool equal = true;
+			for (int i = 0; i < BatchRandom::blockSize + 2; i++) {
+				uint64_t bits = bitsOf(random.next());
+				if (i < 4) equal &= bits == expected[i];
+				if (i >= BatchRandom::blockSize) equal &= bits == expected[i - BatchRandom::blockSize + 4];
+			}
+			AssertThat(equal, IsTrue());
+		});
+	});
+});
@@ -0,0 +1,232 @@
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "bandit/bandit.h"
+
+#include "../common/Checkpoint.h"
+#include "../common/Ensemble.h"
+#include "../common/Generators.h"
+#include "../common/Random.h"
+#include "../tests/edges.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+using namespace ogdf::testing;
+
+//! Edge sink that stops the generator by throwing after a number of edges.
+class InterruptedSink : public EdgeListSink {
+	long long m_remaining;
+
+public:
+	InterruptedSink(Edges &edges, long long limit) : EdgeListSink(edges), m_remaining(limit) { }
+
+	using EdgeListSink::addEdge;
+
+	void addEdge(int u, int v) override {
+		if (m_remaining-- == 0) {
+			throw std::runtime_error("interrupted");
+		}
+		EdgeListSink::addEdge(u, v);
+	}
+};
+
+go_bandit([](){
+	const std::string path = (std::filesystem::temp_directory_path() / "ogdf-generators-checkpoint-test").string();
+
+	describe("Checkpoint", [&](){
+		it("restores the arrays and scalars of the last complete record", [&](){
+			std::filesystem::remove(path);
+			std::vector<int> values = {1, 2, 3, 4, 5, 6, 7};
+			{
+				std::vector<int> restored;
+				std::vector<uint64_t> scalars = {0};
+				Checkpoint checkpoint(path, 0);
+				AssertThat(checkpoint.resume("test", "a", {&restored}, scalars), IsFalse());
+				AssertThat(checkpoint.save({{values.data(), 3}}, {3}), IsTrue());
+				checkpoint.wait();
+				AssertThat(checkpoint.save({{values.data(), 7}}, {7}), IsTrue());
+				checkpoint.wait();
+				AssertThat(checkpoint.records(), Equals(2));
+				AssertThat(checkpoint.good(), IsTrue());
+			}
+			{
+				std::vector<int> restored;
+				std::vector<uint64_t> scalars = {0};
+				Checkpoint checkpoint(path, 0);
+				AssertThat(checkpoint.resume("test", "a", {&restored}, scalars), IsTrue());
+				AssertThat(restored == values, IsTrue());
+				AssertThat(scalars[0], Equals(7u));
+			}
+
+			// cutting the second record, which is then ignored and cut off
+			std::filesystem::resize_file(path, std::filesystem::file_size(path) - 5);
+			{
+				std::vector<int> restored;
+				std::vector<uint64_t> scalars = {0};
+				Checkpoint checkpoint(path, 0);
+				AssertThat(checkpoint.resume("test", "a", {&restored}, scalars), IsTrue());
+				AssertThat(restored == std::vector<int>({1, 2, 3}), IsTrue());
+				AssertThat(scalars[0], Equals(3u));
+			}
+			AssertThat(std::filesystem::file_size(path), Equals(CheckpointHeader::size + 8 + 3 * sizeof(int) + 2 * 8));
+		});
+
+		it("refuses the checkpoints of other parameters and keeps them", [&](){
+			std::filesystem::remove(path);
+			std::vector<int> values = {1, 2, 3};
+			{
+				std::vector<int> restored;
+				std::vector<uint64_t> scalars = {0};
+				Checkpoint checkpoint(path, 0);
+				checkpoint.resume("test", "a", {&restored}, scalars);
+				checkpoint.save({{values.data(), 3}}, {3});
+			}
+			uintmax_t size = std::filesystem::file_size(path);
+			AssertThat(size, IsGreaterThan(CheckpointHeader::size));
+
+			std::vector<int> restored;
+			std::vector<uint64_t> scalars = {0};
+			Checkpoint checkpoint(path, 0);
+			bool refused = false;
+			try {
+				checkpoint.resume("test", "b", {&restored}, scalars);
+			} catch (const CheckpointMismatch &) {
+				refused = true;
+			}
+			AssertThat(refused, IsTrue());
+			AssertThat(restored.empty(), IsTrue());
+			AssertThat(std::filesystem::file_size(path), Equals(size));
+		});
+
+		it("refuses a file that is no checkpoint", [&](){
+			std::filesystem::remove(path);
+			{
+				std::ofstream file(path);
+				file << "edges";
+			}
+			std::vector<int> restored;
+			std::vector<uint64_t> scalars = {0};
+			Checkpoint checkpoint(path, 0);
+			bool refused = false;
+			try {
+				checkpoint.resume("test", "a", {&restored}, scalars);
+			} catch (const CheckpointMismatch &) {
+				refused = true;
+			}
+			AssertThat(refused, IsTrue());
+			AssertThat(std::filesystem::file_size(path), Equals(5u));
+		});
+
+		it("starts a new file in place of an empty one", [&](){
+			std::filesystem::remove(path);
+			std::ofstream(path).close();
+			std::vector<int> restored;
+			std::vector<uint64_t> scalars = {0};
+			Checkpoint checkpoint(path, 0);
+			AssertThat(checkpoint.resume("test", "a", {&restored}, scalars), IsFalse());
+			AssertThat(checkpoint.good(), IsTrue());
+			AssertThat(std::filesystem::file_size(path), Equals(CheckpointHeader::size));
+		});
+
+		it("restores several arrays record by record", [&](){
+			std::filesystem::remove(path);
+			std::vector<int> first = {1, 2, 3, 4, 5}, second = {9, 8, 7};
+			{
+				std::vector<int> restored1, restored2;
+				std::vector<uint64_t> scalars = {0, 0};
+				Checkpoint checkpoint(path, 0);
+				checkpoint.resume("test", "a", {&restored1, &restored2}, scalars);
+				checkpoint.save({{first.data(), 2}, {second.data(), 0}}, {1, 2});
+				checkpoint.save({{first.data(), 2}, {second.data(), 3}}, {3, 4});
+				checkpoint.save({{first.data(), 5}, {second.data(), 3}}, {5, 6});
+				checkpoint.wait();
+			}
+			std::vector<int> restored1 = {0}, restored2;
+			std::vector<uint64_t> scalars = {0, 0};
+			Checkpoint checkpoint(path, 0);
+			AssertThat(checkpoint.resume("test", "a", {&restored1, &restored2}, scalars), IsTrue());
+			AssertThat(restored1 == std::vector<int>({0, 1, 2, 3, 4, 5}), IsTrue());
+			AssertThat(restored2 == second, IsTrue());
+			AssertThat(scalars == std::vector<uint64_t>({5, 6}), IsTrue());
+		});
+	});
+
+	describe("preferentialAttachmentGraph with a checkpoint", [&](){
+		auto plain = [](EdgeSink &sink) { preferentialAttachmentGraph(sink, 400, 3); };
+
+		it("generates the same graph as without a checkpoint", [&](){
+			std::filesystem::remove(path);
+			Checkpoint checkpoint(path, 0);
+			Edges edges = generateEdges(7, [&](EdgeSink &sink) { preferentialAttachmentGraph(sink, 400, 3, checkpoint); });
+			AssertThat(edges == generateEdges(7, plain), IsTrue());
+		});
+
+		it("resumes an interrupted run", [&](){
+			std::filesystem::remove(path);
+			{
+				Checkpoint checkpoint(path, 0);
+				Edges edges;
+				InterruptedSink sink(edges, 700);
+				SeedScope scope(7);
+				bool interrupted = false;
+				try {
+					preferentialAttachmentGraph(sink, 400, 3, checkpoint);
+				} catch (const std::runtime_error &) {
+					interrupted = true;
+				}
+				AssertThat(interrupted, IsTrue());
+				checkpoint.wait();
+				AssertThat(checkpoint.records(), IsGreaterThan(0));
+			}
+			Checkpoint checkpoint(path, 0);
+			Edges edges = generateEdges(8, [&](EdgeSink &sink) { preferentialAttachmentGraph(sink, 400, 3, checkpoint); });
+			AssertThat(edges == generateEdges(7, plain), IsTrue());
+		});
+
+		it("refuses the checkpoint of a run with other parameters", [&](){
+			std::filesystem::remove(path);
+			{
+				Checkpoint checkpoint(path, 0);
+				generateEdges(7, [&](EdgeSink &sink) { preferentialAttachmentGraph(sink, 300, 3, checkpoint); });
+			}
+			uintmax_t size = std::filesystem::file_size(path);
+			bool refused = false;
+			try {
+				Checkpoint checkpoint(path, 0);
+				generateEdges(8, [&](EdgeSink &sink) { preferentialAttachmentGraph(sink, 400, 3, checkpoint); });
+			} catch (const CheckpointMismatch &) {
+				refused = true;
+			}
+			AssertThat(refused, IsTrue());
+			AssertThat(std::filesystem::file_size(path), Equals(size));
+
+			// the kept checkpoint still resumes its own run
+			Checkpoint checkpoint(path, 0);
+			Edges edges = generateEdges(8, [&](EdgeSink &sink) { preferentialAttachmentGraph(sink, 300, 3, checkpoint); });
+			AssertThat(edges == generateEdges(7, [](EdgeSink &sink) { preferentialAttachmentGraph(sink, 300, 3); }), IsTrue());
+		});
+	});
+
+	describe("randomBipartitePrefrentialGraph with a checkpoint", [&](){
+		for (int d : {1, 3}) {
+			it("resumes from a torn checkpoint file", [&, d](){
+				std::filesystem::remove(path);
+				auto plain = [d](EdgeSink &sink) { randomBipartitePrefrentialGraph(sink, 200, d); };
+				{
+					Checkpoint checkpoint(path, 0);
+					Edges edges = generateEdges(5, [&](EdgeSink &sink) { randomBipartitePrefrentialGraph(sink, 200, d, checkpoint); });
+					AssertThat(edges == generateEdges(5, plain), IsTrue());
+				}
+				std::filesystem::resize_file(path, std::filesystem::file_size(path) * 3 / 5);
+
+				Checkpoint checkpoint(path, 0);
+				Edges edges = generateEdges(6, [&](EdgeSink &sink) { randomBipartitePrefrentialGraph(sink, 200, d, checkpoint); });
+				AssertThat(edges == generateEdges(5, plain), IsTrue());
+			});
+		}
+	});
+
+	std::filesystem::remove(path);
+});
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "bandit/bandit.h"
+
+#include "../common/CompressedGraph.h"
+#include "../common/Generators.h"
+#include "../tests/edges.h"
+
+using namespace ogdf;
+using namespace ogdf::testing;
+using namespace bandit;
+
+//! Checks that \p compressed holds the graph of \p csr.
+static void assertSameGraph(const CompressedGraphSink &compressed, const CsrSink &csr) {
+	AssertThat(compressed.numberOfNodes(), Equals(csr.numberOfNodes()));
+	AssertThat(compressed.numberOfEdges(), Equals(csr.numberOfEdges()));
+
+	std::vector<uint32_t> expected;
+	std::vector<uint32_t> neighbors, successors;
+	for (int v = 0; v < csr.numberOfNodes(); v++) {
+		expected.assign(csr.targets().begin() + csr.offsets()[v], csr.targets().begin() + csr.offsets()[v + 1]);
+		std::sort(expected.begin(), expected.end());
+
+		neighbors.clear();
+		compressed.forEachNeighbor(v, [&](int w) { neighbors.push_back((uint32_t)w); });
+		AssertThat(neighbors == expected, IsTrue());
+		AssertThat(compressed.degree(v), Equals(csr.degree(v)));
+
+		successors.clear();
+		compressed.forEachSuccessor(v, [&](int w) { successors.push_back((uint32_t)w); });
+		// a self-loop is both the last predecessor and the first successor
+		size_t predecessors = expected.size() - successors.size();
+		AssertThat(std::equal(successors.begin(), successors.end(), expected.begin() + predecessors), IsTrue());
+		AssertThat(predecessors == 0 || expected[predecessors - 1] <= (uint32_t)v, IsTrue());
+		AssertThat(successors.empty() || successors.front() >= (uint32_t)v, IsTrue());
+	}
+}
+
+go_bandit([](){
+	describe("CompressedGraphSink", [&](){
+		auto compare = [](uint64_t seed, const Ensemble::Model &generate, size_t runSize) {
+			CompressedGraphSink compressed(runSize);
+			CsrSink csr;
+			{
+				SeedScope scope(seed);
+				generate(compressed);
+			}
+			{
+				SeedScope scope(seed);
+				generate(csr);
+			}
+			assertSameGraph(compressed, csr);
+
+			Edges edges;
+			compressed.forEachEdge([&](int u, int v) { edges.emplace_back((uint32_t)u, (uint32_t)v); });
+			AssertThat(std::is_sorted(edges.begin(), edges.end()), IsTrue());
+			AssertThat(edges == sortedEdges(generateEdges(seed, generate)), IsTrue());
+		};
+
+		for (size_t runSize : {size_t(1) << 22, size_t(1000)}) {
+			it("holds the neighborhoods of a random regular graph", [&, runSize](){
+				compare(1, [](EdgeSink &sink) { randomRegularGraph(sink, 20000, 3); }, runSize);
+			});
+
+			it("holds the neighborhoods of a Watts-Strogatz graph", [&, runSize](){
+				compare(2, [](EdgeSink &sink) { randomWattsStrogatzGraph(sink, 5000, 6, 0.1); }, runSize);
+			});
+
+			it("holds self-loops, multi-edges and isolated nodes", [&, runSize](){
+				compare(3, [](EdgeSink &sink) {
+					for (int v = 0; v < 100; v++) {
+						sink.addNode();
+					}
+					RandomEngine rng(generatorSeed());
+					std::uniform_int_distribution<int> dist(0, 60);
+					for (int i = 0; i < 3000; i++) {
+						int u = dist(rng) * (dist(rng) % 2);
+						sink.addEdge(u, dist(rng));
+					}
+					sink.addEdge(99, 99);
+					sink.finish();
+				}, runSize);
+			});
+		}
+
+		it("holds an empty graph", [&](){
+			CompressedGraphSink compressed;
+			compressed.addNode();
+			compressed.finish();
+			AssertThat(compressed.degree(0), Equals(0u));
+			compressed.forEachEdge([](int, int) { AssertThat(false, IsTrue()); });
+		});
+
+		it("takes 2-3 bytes per edge for the successor lists of a random regular graph", [&](){
+			CompressedGraphSink compressed;
+			SeedScope scope(4);
+			randomRegularGraph(compressed, 200000, 3);
+			double edges = (double)compressed.numberOfEdges();
+			AssertThat(compressed.successorBytes() / edges <= 3.0, IsTrue());
+			AssertThat(compressed.predecessorBytes() / edges <= 3.0, IsTrue());
+			AssertThat(compressed.sizeInBytes() / edges <= 6.0, IsTrue());
+		});
+	});
+});
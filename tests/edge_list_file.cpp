@@ -0,0 +1,106 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+
+#include "bandit/bandit.h"
+
+#include "../common/EdgeListFile.h"
+#include "../common/Generators.h"
+#include "../tests/edges.h"
+
+using namespace ogdf;
+using namespace ogdf::testing;
+using namespace bandit;
+
+go_bandit([](){
+	const std::string path = (std::filesystem::temp_directory_path() / "ogdf-generators-edge-list-test").string();
+
+	describe("EdgeListFile", [&](){
+		// 1000 edges of 8 bytes, so the tail behind the last full block of 4096 bytes is not aligned
+		auto generate = [](EdgeSink &sink) { randomWattsStrogatzGraph(sink, 500, 4, 0.2); };
+		Edges expected = generateEdges(3, generate);
+
+		auto write = [&](size_t bufferSize) {
+			EdgeListFileSink file(path, "watts-strogatz", "n=500 k=4 p=0.2", 3, bufferSize);
+			SeedScope scope(3);
+			generate(file);
+			AssertThat(file.good(), IsTrue());
+			AssertThat(file.numberOfEdges(), Equals(expected.size()));
+		};
+
+		it("reads the edges it wrote", [&](){
+			for (size_t bufferSize : {4096, 1 << 20}) {
+				std::filesystem::remove(path);
+				write(bufferSize);
+				// an O_DIRECT writer pads the tail to a whole block and truncates the padding
+				AssertThat(std::filesystem::file_size(path), Equals(EdgeListFileHeader::size + 8 * expected.size()));
+
+				EdgeListFile file;
+				AssertThat(file.open(path), IsTrue());
+				AssertThat(file.numberOfNodes(), Equals(500u));
+				AssertThat(file.numberOfEdges(), Equals(expected.size()));
+				AssertThat(file.header().seed, Equals(3u));
+				AssertThat(std::string(file.header().model) == "watts-strogatz", IsTrue());
+				AssertThat(std::string(file.header().parameters) == "n=500 k=4 p=0.2", IsTrue());
+
+				Edges edges;
+				EdgeListSink sink(edges);
+				file.replay(sink);
+				AssertThat(sink.numberOfNodes(), Equals(500));
+				AssertThat(edges == expected, IsTrue());
+
+				CsrSink csr, reference;
+				file.toCsr(csr);
+				SeedScope scope(3);
+				generate(reference);
+				AssertThat(csr.offsets() == reference.offsets(), IsTrue());
+				AssertThat(csr.targets() == reference.targets(), IsTrue());
+			}
+		});
+
+		it("rejects a file with a different header", [&](){
+			auto corrupt = [&](size_t offset, char byte) {
+				std::filesystem::remove(path);
+				write(1 << 20);
+				std::fstream stream(path, std::ios::in | std::ios::out | std::ios::binary);
+				stream.seekp((std::streamoff)offset);
+				stream.put(byte);
+			};
+			EdgeListFile file;
+
+			corrupt(offsetof(EdgeListFileHeader, magicBytes), 'X');
+			AssertThat(file.open(path), IsFalse());
+			corrupt(offsetof(EdgeListFileHeader, version), 2);
+			AssertThat(file.open(path), IsFalse());
+			corrupt(offsetof(EdgeListFileHeader, byteOrder), 0);
+			AssertThat(file.open(path), IsFalse());
+			corrupt(offsetof(EdgeListFileHeader, numberOfEdges), 1);
+			AssertThat(file.open(path), IsFalse());
+
+			// a file whose last edges are missing
+			std::filesystem::remove(path);
+			write(1 << 20);
+			std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+			AssertThat(file.open(path), IsFalse());
+			std::filesystem::resize_file(path, EdgeListFileHeader::size - 1);
+			AssertThat(file.open(path), IsFalse());
+		});
+
+		it("reports a file that cannot be created or read", [&](){
+			std::string missing = (std::filesystem::temp_directory_path() / "ogdf-generators-missing" / "edges.bin").string();
+			EdgeListFileSink sink(missing, "empty", "", 0);
+			AssertThat(sink.good(), IsFalse());
+			sink.addNode();
+			sink.addEdge(0, 0);
+			sink.finish();
+			AssertThat(sink.good(), IsFalse());
+
+			EdgeListFile file;
+			AssertThat(file.open(missing), IsFalse());
+			Graph G;
+			AssertThat(readEdgeListFile(missing, G), IsFalse());
+		});
+	});
+
+	std::filesystem::remove(path);
+});
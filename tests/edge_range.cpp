@@ -0,0 +1,105 @@
+#include <atomic>
+#include <stdexcept>
+
+#include "bandit/bandit.h"
+
+#include "../common/EdgeRange.h"
+#include "../common/Generators.h"
+#include "../tests/edges.h"
+
+using namespace ogdf;
+using namespace ogdf::testing;
+using namespace bandit;
+
+//! Counts its instances that were destroyed, to check that a generator's stack is unwound.
+struct UnwindProbe {
+	std::atomic<int> &destroyed;
+
+	explicit UnwindProbe(std::atomic<int> &counter) : destroyed(counter) { }
+	~UnwindProbe() { destroyed++; }
+};
+
+go_bandit([](){
+	describe("EdgeRange", [&](){
+		auto generate = [](EdgeSink &sink) { randomWattsStrogatzGraph(sink, 3000, 4, 0.2); };
+
+		it("yields the edges of the generator in order", [&](){
+			Edges expected = generateEdges(11, generate);
+			for (size_t blockSize : {1, 7, 4096}) {
+				Edges edges;
+				SeedScope scope(11);
+				// the generator thread draws its seeds from the scope of this thread
+				EdgeRange range(generate, blockSize, 2);
+				for (const auto &e : range) {
+					edges.emplace_back((uint32_t)e.first, (uint32_t)e.second);
+				}
+				AssertThat(range.numberOfNodes(), Equals(3000));
+				AssertThat(edges == expected, IsTrue());
+			}
+		});
+
+		it("yields nothing for a generator without edges", [&](){
+			EdgeRange range([](EdgeSink &sink) { sink.addNode(); });
+			AssertThat(range.begin() == range.end(), IsTrue());
+			AssertThat(range.numberOfNodes(), Equals(1));
+		});
+
+		it("stops the generator when the range is destroyed early", [&](){
+			std::atomic<long long> produced{0};
+			std::atomic<int> destroyed{0};
+			long long consumed = 0;
+			{
+				EdgeRange range([&](EdgeSink &sink) {
+					UnwindProbe probe(destroyed);
+					sink.addNode();
+					for (;;) {
+						sink.addEdge(0, 0);
+						produced++;
+					}
+				}, 16, 2);
+				for (auto it = range.begin(); it != range.end() && consumed < 100; ++it) {
+					consumed++;
+				}
+			}
+			AssertThat(consumed, Equals(100));
+			AssertThat(destroyed.load(), Equals(1));
+			// the consumed blocks, the blocks in flight and the one being filled
+			AssertThat(produced.load() <= consumed + 16 * 4, IsTrue());
+		});
+
+		it("stops a generator whose edges are never consumed", [&](){
+			std::atomic<int> destroyed{0};
+			{
+				EdgeRange range([&](EdgeSink &sink) {
+					UnwindProbe probe(destroyed);
+					for (int i = 0; i < 100000; i++) {
+						sink.addEdge(i, i);
+					}
+				}, 8, 1);
+			}
+			AssertThat(destroyed.load(), Equals(1));
+		});
+
+		it("rethrows an exception of the generator to the consumer", [&](){
+			EdgeRange range([](EdgeSink &sink) {
+				for (int i = 0; i < 50; i++) {
+					sink.addEdge(i, i + 1);
+				}
+				throw std::runtime_error("generator failed");
+			}, 8, 2);
+
+			long long consumed = 0;
+			bool thrown = false;
+			try {
+				for (const auto &e : range) {
+					AssertThat(e.second, Equals(e.first + 1));
+					consumed++;
+				}
+			} catch (const std::runtime_error &) {
+				thrown = true;
+			}
+			AssertThat(thrown, IsTrue());
+			AssertThat(consumed >= 48 && consumed <= 50, IsTrue());
+		});
+	});
+});
@@ -0,0 +1,45 @@
+/** \file
+ * \brief Helpers for the specifications that compare the edges generated
+ * with fixed seeds.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "../common/EdgeSink.h"
+#include "../common/Ensemble.h"
+#include "../common/Parallel.h"
+#include "../common/Random.h"
+
+namespace ogdf {
+namespace testing {
+
+using Edges = Ensemble::Edges;
+
+//! Returns the edges written by \p generate inside a SeedScope(\p seed), on up to \p threads threads if \p threads > 0.
+inline Edges generateEdges(uint64_t seed, const Ensemble::Model &generate, int threads = 0) {
+	Edges edges;
+	EdgeListSink sink(edges);
+	SeedScope scope(seed);
+	if (threads > 0) {
+		ThreadLimit limit(threads);
+		generate(sink);
+	} else {
+		generate(sink);
+	}
+	return edges;
+}
+
+//! Returns \p edges with every edge written as (smaller, larger), sorted.
+inline Edges sortedEdges(Edges edges) {
+	for (auto &e : edges) {
+		e = {std::min(e.first, e.second), std::max(e.first, e.second)};
+	}
+	std::sort(edges.begin(), edges.end());
+	return edges;
+}
+
+}
+}
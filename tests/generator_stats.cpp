@@ -0,0 +1,144 @@
+#include <chrono>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "bandit/bandit.h"
+
+#include "../common/EdgeSink.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Generators.h"
+#include "../common/Parallel.h"
+#include "../common/Random.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+go_bandit([](){
+#ifdef OGDF_GENERATORS_STATS
+	describe("GeneratorStats", [&](){
+		it("counts the pairs and edges of a pair loop", [&](){
+			generatorStats().reset();
+			CountingSink sink;
+			SeedScope scope(1);
+			randomGeometricCubeGraph(sink, 300, 0.1);
+
+			const GeneratorStats &stats = generatorStats();
+			AssertThat(stats.calls, Equals(1u));
+			AssertThat(stats.pairsExamined, Equals(300u * 299 / 2));
+			AssertThat(stats.edgesEmitted, Equals((uint64_t)sink.numberOfEdges()));
+			AssertThat(stats.edgesEmitted, IsGreaterThan(0u));
+			AssertThat(stats.randomDraws, IsGreaterThan(0u));
+		});
+
+		it("counts the restarts and rejections of randomRegularGraph", [&](){
+			generatorStats().reset();
+			CountingSink sink;
+			SeedScope scope(2);
+			randomRegularGraph(sink, 1000, 3);
+
+			const GeneratorStats &stats = generatorStats();
+			AssertThat(stats.edgesEmitted, Equals(1500u));
+			// every attempt pairs all points
+			AssertThat(stats.pairsExamined, Equals(1500 * (stats.restarts + 1)));
+			AssertThat(stats.rejections, IsGreaterThan(0u));
+		});
+
+		it("times the phases of a generator call", [&](){
+			generatorStats().reset();
+			Graph G;
+			auto start = std::chrono::steady_clock::now();
+			{
+				GraphSink sink(G);
+				SeedScope scope(3);
+				randomWattsStrogatzGraph(sink, 100000, 10, 0.1);
+			}
+			double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			const GeneratorStats &stats = generatorStats();
+			double total = stats.time(GeneratorStats::Phase::Setup) + stats.time(GeneratorStats::Phase::Edges) + stats.time(GeneratorStats::Phase::Finish);
+			AssertThat(stats.time(GeneratorStats::Phase::Edges), IsGreaterThan(0.0));
+			AssertThat(stats.time(GeneratorStats::Phase::Finish), IsGreaterThan(0.0));
+			AssertThat(total <= wall, IsTrue());
+		});
+
+		it("times only the outermost probe of a thread", [&](){
+			generatorStats().reset();
+			auto start = std::chrono::steady_clock::now();
+			{
+				GeneratorProbe outer;
+				CountingSink sink;
+				SeedScope scope(4);
+				randomGeometricCubeGraph(sink, 2000, 0.05);
+			}
+			double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			const GeneratorStats &stats = generatorStats();
+			AssertThat(stats.calls, Equals(2u));
+			AssertThat(stats.time(GeneratorStats::Phase::Edges), Equals(0.0));
+			AssertThat(stats.time(GeneratorStats::Phase::Setup) <= wall, IsTrue());
+			AssertThat(stats.time(GeneratorStats::Phase::Setup) > 0.5 * wall, IsTrue());
+		});
+
+		it("keeps the statistics of every thread apart", [&](){
+			generatorStats().reset();
+			uint64_t edges = 0;
+			std::thread worker([&] {
+				CountingSink sink;
+				randomGeometricTorusGraph(sink, 200, 0.1);
+				edges = generatorStats().edgesEmitted;
+			});
+			worker.join();
+			AssertThat(edges, IsGreaterThan(0u));
+			AssertThat(generatorStats().calls, Equals(0u));
+		});
+
+		it("adds the statistics of the worker threads of a parallel generator", [&](){
+			auto draws = [](int threads, const std::function<void(EdgeSink &)> &generate) {
+				generatorStats().reset();
+				CountingSink sink;
+				ThreadLimit limit(threads);
+				SeedScope scope(3);
+				generate(sink);
+				AssertThat(generatorStats().edgesEmitted, Equals((uint64_t)sink.numberOfEdges()));
+				return generatorStats().randomDraws;
+			};
+			auto rmat = [](EdgeSink &sink) { randomRMatGraph(sink, 14); };
+			auto hyperbolic = [](EdgeSink &sink) { randomHyperbolicGraphFast(sink, 20000, 10, 2.5, 0.5); };
+
+			AssertThat(draws(1, rmat), IsGreaterThan(0u));
+			AssertThat(draws(4, rmat), Equals(draws(1, rmat)));
+			AssertThat(draws(1, hyperbolic), IsGreaterThan(0u));
+			AssertThat(draws(4, hyperbolic), Equals(draws(1, hyperbolic)));
+		});
+
+		it("writes the counters as key=value pairs", [&](){
+			generatorStats().reset();
+			CountingSink sink;
+			randomRegularGraph(sink, 100, 4);
+			std::ostringstream line;
+			line << generatorStats();
+			AssertThat(line.str().find("calls=1 ") == 0, IsTrue());
+			AssertThat(line.str().find(" edgesEmitted=200") != std::string::npos, IsTrue());
+		});
+	});
+#else
+	describe("GeneratorStats without OGDF_GENERATORS_STATS", [&](){
+		static_assert(std::is_empty<GeneratorProbe>::value, "the probe must compile out");
+
+		it("stays zero", [&](){
+			generatorStats().reset();
+			CountingSink sink;
+			randomGeometricCubeGraph(sink, 300, 0.1);
+			randomRegularGraph(sink, 100, 4);
+			const GeneratorStats &stats = generatorStats();
+			AssertThat(stats.calls, Equals(0u));
+			AssertThat(stats.randomDraws, Equals(0u));
+			AssertThat(stats.pairsExamined, Equals(0u));
+			AssertThat(stats.edgesEmitted, Equals(0u));
+		});
+	});
+#endif
+});
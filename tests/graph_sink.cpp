@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "bandit/bandit.h"
+
+#include "../common/EdgeSink.h"
+#include "../common/Parallel.h"
+#include "../common/Random.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+//! Source, target and cost of an edge.
+using CostEdge = std::tuple<int, int, double>;
+
+//! Returns the edges of \p G in their order with their \p cost.
+static std::vector<CostEdge> edgesOf(const Graph &G, const EdgeArray<double> &cost) {
+	std::vector<CostEdge> edges;
+	for (edge e : G.edges) {
+		edges.emplace_back(e->source()->index(), e->target()->index(), cost[e]);
+	}
+	return edges;
+}
+
+//! Returns the indices of the edges at every node of \p G in the order of its adjacency list.
+static std::vector<std::vector<int>> adjacencyOf(const Graph &G) {
+	std::vector<std::vector<int>> adjacency;
+	for (node v : G.nodes) {
+		adjacency.emplace_back();
+		for (adjEntry adj : v->adjEntries) {
+			adjacency.back().push_back(adj->theEdge()->index());
+		}
+	}
+	return adjacency;
+}
+
+go_bandit([](){
+	describe("GraphSink", [&](){
+		// enough edges per node that finish() sorts them with several threads
+		const int n = 300;
+		std::vector<CostEdge> input;
+		RandomEngine rng(17);
+		std::uniform_int_distribution<int> endpoint(0, n - 1);
+		for (int i = 0; i < 50 * n; i++) {
+			input.emplace_back(endpoint(rng), endpoint(rng), (double)i);
+		}
+
+		auto build = [&](Graph &G, EdgeArray<double> *cost, int maxThreads) {
+			ThreadLimit limit(maxThreads);
+			GraphSink sink(G, cost);
+			for (int v = G.numberOfNodes(); v < n; v++) {
+				sink.addNode();
+			}
+			for (const CostEdge &e : input) {
+				sink.addEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+			}
+			sink.finish();
+		};
+
+		it("inserts the edges stably sorted by source", [&](){
+			Graph G;
+			EdgeArray<double> cost;
+			build(G, &cost, 1);
+
+			std::vector<CostEdge> expected = input;
+			std::stable_sort(expected.begin(), expected.end(),
+				[](const CostEdge &a, const CostEdge &b) { return std::get<0>(a) < std::get<0>(b); });
+			AssertThat(G.numberOfNodes(), Equals(n));
+			AssertThat(edgesOf(G, cost) == expected, IsTrue());
+		});
+
+		for (int threads : {2, 3, 8, 64}) {
+			it("builds the same graph with several threads", [&, threads](){
+				Graph reference, G;
+				EdgeArray<double> referenceCost, cost;
+				build(reference, &referenceCost, 1);
+				build(G, &cost, threads);
+
+				AssertThat(edgesOf(G, cost) == edgesOf(reference, referenceCost), IsTrue());
+				AssertThat(adjacencyOf(G) == adjacencyOf(reference), IsTrue());
+			});
+		}
+
+		it("builds the same graph with several threads without costs", [&](){
+			Graph reference, G;
+			build(reference, nullptr, 1);
+			build(G, nullptr, 8);
+			AssertThat(adjacencyOf(G) == adjacencyOf(reference), IsTrue());
+		});
+
+		it("keeps the nodes of a graph it extends", [&](){
+			Graph reference, G;
+			EdgeArray<double> referenceCost, cost;
+			for (int v = 0; v < 10; v++) {
+				reference.newNode();
+				G.newNode();
+			}
+			build(reference, &referenceCost, 1);
+			build(G, &cost, 8);
+			AssertThat(G.numberOfNodes(), Equals(n));
+			AssertThat(edgesOf(G, cost) == edgesOf(reference, referenceCost), IsTrue());
+			AssertThat(adjacencyOf(G) == adjacencyOf(reference), IsTrue());
+		});
+	});
+});
@@ -0,0 +1,9 @@
+/** \file
+ * \brief Runs the bandit specifications of all generators.
+ */
+
+#include <bandit/bandit.h>
+
+int main(int argc, char *argv[]) {
+	return bandit::run(argc, argv);
+}
@@ -0,0 +1,117 @@
+#include "bandit/bandit.h"
+
+#include "../common/Ensemble.h"
+#include "../common/Generators.h"
+#include "../common/Random.h"
+#include "../tests/edges.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+using namespace ogdf::testing;
+
+static void describeReproducibility(const char *name, const Ensemble::Model &generate) {
+	describe(name, [&](){
+		it("generates the same graph for the same seed", [&](){
+			Edges first = generateEdges(17, generate);
+			setSeed(4711);
+			Edges second = generateEdges(17, generate);
+			AssertThat(first == second, IsTrue());
+		});
+		it("generates different graphs for different seeds", [&](){
+			AssertThat(generateEdges(17, generate) == generateEdges(18, generate), IsFalse());
+		});
+	});
+}
+
+go_bandit([](){
+	describe("CounterStream", [&](){
+		it("computes the Philox4x32-10 known answers", [&](){
+			uint32_t zero[4] = {0, 0, 0, 0};
+			philox4x32(zero, 0, 0);
+			AssertThat(zero[0] == 0x6627e8d5u && zero[1] == 0xe169c58du
+				&& zero[2] == 0xbc57ac4cu && zero[3] == 0x9b00dbd8u, IsTrue());
+
+			uint32_t pi[4] = {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u};
+			philox4x32(pi, 0xa4093822u, 0x299f31d0u);
+			AssertThat(pi[0] == 0xd16cfe09u && pi[1] == 0x94fdccebu
+				&& pi[2] == 0x5001e420u && pi[3] == 0x24126ea1u, IsTrue());
+		});
+
+		it("regenerates any position of a block on its own", [&](){
+			CounterStream sequential(99, 3, 12345);
+			std::vector<uint64_t> numbers;
+			for (int i = 0; i < 9; i++) {
+				numbers.push_back(sequential());
+			}
+			for (int i = 0; i < 9; i++) {
+				CounterStream random(99, 3, 0);
+				random.seek(12345, i);
+				AssertThat(random() == numbers[i], IsTrue());
+			}
+		});
+
+		it("gives different numbers for different streams and blocks", [&](){
+			AssertThat(CounterStream(99, 3, 7)() == CounterStream(99, 4, 7)(), IsFalse());
+			AssertThat(CounterStream(99, 3, 7)() == CounterStream(99, 3, 8)(), IsFalse());
+		});
+	});
+
+	describe("RandomEngine", [&](){
+		it("gives different streams for seeds that are equal modulo 2^31 - 1", [&](){
+			RandomEngine first(12345), second(12345 + 0x7fffffffULL);
+			AssertThat(first() == second(), IsFalse());
+		});
+
+		it("continues the same sequence from its state", [&](){
+			RandomEngine rng(99);
+			rng();
+			uint64_t state[RandomEngine::stateSize];
+			for (int i = 0; i < RandomEngine::stateSize; i++) {
+				state[i] = rng.state(i);
+			}
+			RandomEngine resumed(7);
+			resumed.setState(state);
+			for (int i = 0; i < 10; i++) {
+				AssertThat(resumed() == rng(), IsTrue());
+			}
+		});
+	});
+
+	describeReproducibility("randomChungLuGraph", [](EdgeSink &sink) {
+		Array<int> weights(60);
+		for (int &w : weights) w = 5;
+		randomChungLuGraph(sink, weights);
+	});
+	describeReproducibility("randomChungLuRandomWeightsGraph", [](EdgeSink &sink) { randomChungLuRandomWeightsGraph(sink, 200); });
+	describeReproducibility("norrosReittuRandomWeightsGraph", [](EdgeSink &sink) { norrosReittuRandomWeightsGraph(sink, 200); });
+	describeReproducibility("preferentialAttachmentGraph", [](EdgeSink &sink) { preferentialAttachmentGraph(sink, 60, 3); });
+	describeReproducibility("randomBipartitePrefrentialGraph", [](EdgeSink &sink) { randomBipartitePrefrentialGraph(sink, 20, 3); });
+	describeReproducibility("randomWattsStrogatzGraph", [](EdgeSink &sink) { randomWattsStrogatzGraph(sink, 60, 4, 0.3); });
+	describeReproducibility("randomRegularGraph", [](EdgeSink &sink) { randomRegularGraph(sink, 60, 3); });
+	describeReproducibility("randomGeographicalThresholdGraph", [](EdgeSink &sink) { randomGeographicalThresholdGraph(sink, 60, 2.0, 5.0); });
+	describeReproducibility("randomGeographicalThresholdWeightsGraph", [](EdgeSink &sink) {
+		Array<int> weights(60);
+		for (int &w : weights) w = 1;
+		randomGeographicalThresholdWeightsGraph(sink, weights, 2.0, 5.0);
+	});
+	describeReproducibility("randomGeometricCubeGraph", [](EdgeSink &sink) { randomGeometricCubeGraph(sink, 60, 0.3); });
+	describeReproducibility("randomGeometricTorusGraph", [](EdgeSink &sink) { randomGeometricTorusGraph(sink, 60, 0.3); });
+	describeReproducibility("randomRMatGraph", [](EdgeSink &sink) { randomRMatGraph(sink, 8, 4, 0.57, 0.19, 0.19, 0.1); });
+	describeReproducibility("randomKroneckerGraph", [](EdgeSink &sink) {
+		Array<double> initiator(9);
+		for (int i = 0; i < 9; i++) initiator[i] = 1 + i % 4;
+		randomKroneckerGraph(sink, initiator, 5, 500);
+	});
+	describeReproducibility("randomHyperbolicGraph", [](EdgeSink &sink) { randomHyperbolicGraph(sink, 60, 5, 2.5, 0.3); });
+	describeReproducibility("randomHyperbolicGraphFast", [](EdgeSink &sink) { randomHyperbolicGraphFast(sink, 60, 5, 2.5); });
+	describeReproducibility("randomHyperbolicGraphFast at positive temperature", [](EdgeSink &sink) { randomHyperbolicGraphFast(sink, 60, 5, 2.5, 0.3); });
+	describeReproducibility("randomWaxmanGraphUsingPlane", [](EdgeSink &sink) { randomWaxmanGraphUsingPlane(sink, 60, 0.5, 0.2); });
+	describeReproducibility("randomWaxmanGraphUsingPlaneFast", [](EdgeSink &sink) { randomWaxmanGraphUsingPlaneFast(sink, 60, 0.5, 0.2); });
+	describeReproducibility("randomWaxmanGraphUsingGrid", [](EdgeSink &sink) { randomWaxmanGraphUsingGrid(sink, 60, 0.5, 0.2, 10, 10); });
+	describeReproducibility("randomWaxmanGraphUsingGridFast", [](EdgeSink &sink) { randomWaxmanGraphUsingGridFast(sink, 60, 0.5, 0.2, 10, 10); });
+	describeReproducibility("randomWaxmanGraph", [](EdgeSink &sink) { randomWaxmanGraph(sink, 60, 0.5, 0.2); });
+	describeReproducibility("randomWaxmanGraphFast", [](EdgeSink &sink) { randomWaxmanGraphFast(sink, 60, 0.5, 0.2); });
+	describeReproducibility("randomWaxmanGraphIntegral", [](EdgeSink &sink) { randomWaxmanGraphIntegral(sink, 60, 0.5, 0.2, 10); });
+	describeReproducibility("randomWaxmanGraphIntegralFast", [](EdgeSink &sink) { randomWaxmanGraphIntegralFast(sink, 60, 0.5, 0.2, 10); });
+});
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+#include "bandit/bandit.h"
+
+#include "../common/EdgeSink.h"
+#include "../common/Generators.h"
+#include "../common/Random.h"
+#include "../common/ScratchArena.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+//! Number of heap allocations made by the calling thread.
+static thread_local long long t_heapAllocations = 0;
+
+void *operator new(std::size_t size) {
+	t_heapAllocations++;
+	if (void *p = std::malloc(size > 0 ? size : 1)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+	t_heapAllocations++;
+	size_t bytes = (std::max<size_t>(size, 1) + (size_t)alignment - 1) / (size_t)alignment * (size_t)alignment;
+	if (void *p = std::aligned_alloc((size_t)alignment, bytes)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+//! Returns the number of heap allocations of the calling thread in the second and later of \p runs calls of \p generate.
+static long long allocationsAfterFirstRun(const std::function<void(EdgeSink &)> &generate, int runs = 4) {
+	ScratchArena arena;
+	ArenaScope scope(arena);
+	CountingSink sink;
+	SeedScope seeds(1);
+	generate(sink);
+
+	long long before = t_heapAllocations;
+	for (int i = 1; i < runs; i++) {
+		generate(sink);
+	}
+	return t_heapAllocations - before;
+}
+
+go_bandit([](){
+	describe("ScratchArena", [&](){
+		it("merges its blocks when it is rewound completely", [&](){
+			ScratchArena arena;
+			for (int i = 0; i < 3; i++) {
+				ScratchArena::Position start = arena.position();
+				for (size_t size = 1000; size < 200000; size *= 2) {
+					int *values = arena.allocate<int>(size);
+					values[size - 1] = 1;
+				}
+				arena.rewind(start);
+			}
+			// the blocks of the first pass and the merged block
+			size_t allocations = arena.numberOfHeapAllocations();
+			AssertThat(allocations > 1, IsTrue());
+			int *values = arena.allocate<int>(100000);
+			values[0] = 1;
+			arena.reset();
+			AssertThat(arena.numberOfHeapAllocations(), Equals(allocations));
+		});
+
+		it("lets repeated generator calls run without heap allocation", [&](){
+			Array<int> weights(500);
+			for (int i = 0; i < weights.size(); i++) {
+				weights[i] = 1 + i % 4;
+			}
+
+			AssertThat(allocationsAfterFirstRun([](EdgeSink &sink) { randomGeometricCubeGraph(sink, 500, 0.05, 3); }), Equals(0));
+			AssertThat(allocationsAfterFirstRun([](EdgeSink &sink) { randomGeometricTorusGraph(sink, 500, 0.05); }), Equals(0));
+			AssertThat(allocationsAfterFirstRun([](EdgeSink &sink) { randomGeographicalThresholdGraph(sink, 500, 2.0, 50.0); }), Equals(0));
+			AssertThat(allocationsAfterFirstRun([&](EdgeSink &sink) { randomGeographicalThresholdWeightsGraph(sink, weights, 2.0, 50.0); }), Equals(0));
+			AssertThat(allocationsAfterFirstRun([](EdgeSink &sink) { randomBipartitePrefrentialGraph(sink, 300, 3); }), Equals(0));
+			AssertThat(allocationsAfterFirstRun([](EdgeSink &sink) { randomRegularGraph(sink, 300, 3); }), Equals(0));
+		});
+
+		it("detects heap allocations of the generators", [&](){
+			AssertThat(allocationsAfterFirstRun([](EdgeSink &sink) {
+				::operator delete(::operator new(100));
+				sink.addNode();
+			}), Equals(3));
+		});
+	});
+});
@@ -0,0 +1,101 @@
+#include "bandit/bandit.h"
+
+#include "../common/Ensemble.h"
+#include "../common/Generators.h"
+#include "../common/Random.h"
+#include "../common/Shard.h"
+#include "../tests/edges.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+using namespace ogdf::testing;
+
+static void describeShards(const char *name, int n, const Ensemble::Model &generate) {
+	describe(name, [&](){
+		it("generates disjoint shards whose union is the whole graph", [&](){
+			Edges expected = sortedEdges(generateEdges(23, generate));
+			AssertThat(expected.empty(), IsFalse());
+			for (int count : {1, 2, 3, 7}) {
+				Edges edges;
+				for (int index = 0; index < count; index++) {
+					Edges shard;
+					EdgeListSink sink(shard);
+					AssertThat(generateShard(sink, 23, index, count, name, generate), IsTrue());
+					AssertThat(sink.numberOfNodes(), Equals(n));
+					edges.insert(edges.end(), shard.begin(), shard.end());
+				}
+				AssertThat(sortedEdges(edges) == expected, IsTrue());
+			}
+		});
+	});
+}
+
+go_bandit([](){
+	describe("shardBoundary", [&](){
+		it("splits the pairs into consecutive rows of about the same size", [&](){
+			for (int n : {0, 1, 2, 10, 1000}) {
+				for (int count : {1, 2, 5, 64}) {
+					long long total = (long long)n * (n - 1) / 2;
+					int previous = 0;
+					for (int index = 1; index <= count; index++) {
+						int boundary = shardBoundary(n, index, count);
+						AssertThat(boundary >= previous, IsTrue());
+						long long pairs = 0;
+						for (int v = previous; v < boundary; v++) {
+							pairs += n - v - 1;
+						}
+						AssertThat(pairs <= total / count + n, IsTrue());
+						previous = boundary;
+					}
+					AssertThat(previous, Equals(n));
+				}
+			}
+		});
+	});
+
+	describe("generateShard", [&](){
+		Array<int> weights(60);
+		for (int i = 0; i < weights.size(); i++) {
+			weights[i] = 1 + i % 5;
+		}
+
+		describeShards("randomChungLuGraph", 60, [&](EdgeSink &sink) { randomChungLuGraph(sink, weights); });
+		describeShards("randomChungLuRandomWeightsGraph", 60, [](EdgeSink &sink) { randomChungLuRandomWeightsGraph(sink, 60); });
+		describeShards("norrosReittuGraph", 60, [&](EdgeSink &sink) { norrosReittuGraph(sink, weights); });
+		describeShards("norrosReittuRandomWeightsGraph", 60, [](EdgeSink &sink) { norrosReittuRandomWeightsGraph(sink, 60); });
+		describeShards("randomGeographicalThresholdGraph", 60, [](EdgeSink &sink) { randomGeographicalThresholdGraph(sink, 60, 2.0, 6.0); });
+		describeShards("randomGeographicalThresholdWeightsGraph", 60, [&](EdgeSink &sink) { randomGeographicalThresholdWeightsGraph(sink, weights, 2.0, 12.0); });
+		describeShards("randomGeometricCubeGraph", 60, [](EdgeSink &sink) { randomGeometricCubeGraph(sink, 60, 0.2, 2); });
+		describeShards("randomGeometricTorusGraph", 60, [](EdgeSink &sink) { randomGeometricTorusGraph(sink, 60, 0.2); });
+		describeShards("randomHyperbolicGraph", 60, [](EdgeSink &sink) { randomHyperbolicGraph(sink, 60, 6, 2.5, 0.3); });
+		describeShards("randomWaxmanGraphUsingPlane", 60, [](EdgeSink &sink) { randomWaxmanGraphUsingPlane(sink, 60, 0.5, 0.2); });
+		describeShards("randomWaxmanGraphUsingGrid", 60, [](EdgeSink &sink) { randomWaxmanGraphUsingGrid(sink, 60, 0.5, 0.2, 10, 10); });
+		describeShards("randomWaxmanGraph", 60, [](EdgeSink &sink) { randomWaxmanGraph(sink, 60, 0.3, 0.2); });
+		describeShards("randomWaxmanGraphIntegral", 60, [](EdgeSink &sink) { randomWaxmanGraphIntegral(sink, 60, 0.3, 0.2, 20); });
+
+		it("leaves the sink untouched for generators without shards", [&](){
+			auto generate = [](EdgeSink &sink) { randomWaxmanGraphFast(sink, 60, 0.3, 0.2); };
+			Edges edges;
+			EdgeListSink sink(edges);
+			AssertThat(generateShard(sink, 23, 1, 3, "randomWaxmanGraphFast", generate), IsFalse());
+			AssertThat(sink.numberOfNodes(), Equals(0));
+			AssertThat(edges.empty(), IsTrue());
+		});
+	});
+
+	describe("supportsShards", [&](){
+		it("accepts the Waxman reference implementations", [&](){
+			for (const char *name : {"randomWaxmanGraphUsingPlane", "randomWaxmanGraphUsingGrid", "randomWaxmanGraph", "randomWaxmanGraphIntegral"}) {
+				AssertThat(supportsShards(name), IsTrue());
+			}
+		});
+
+		it("rejects the Fast Waxman variants and generators without a pair loop", [&](){
+			for (const char *name : {"randomWaxmanGraphUsingPlaneFast", "randomWaxmanGraphUsingGridFast",
+					"randomWaxmanGraphFast", "randomWaxmanGraphIntegralFast", "randomWattsStrogatzGraph", ""}) {
+				AssertThat(supportsShards(name), IsFalse());
+			}
+		});
+	});
+});
@@ -0,0 +1,239 @@
+/** \file
+ * \brief Statistical tests for comparing the output distributions of two generators.
+ *
+ * A reference generator and an optimized engine are run many times on a
+ * small instance, and the samples are compared by
+ *  - the marginal frequency of every node pair (two-proportion tests with a
+ *    Bonferroni correction),
+ *  - the degree distribution (chi-square homogeneity test on the degree of
+ *    one node per sample, which keeps the observations independent), and
+ *  - the number of edges (Kolmogorov-Smirnov test, comparison of mean and
+ *    Levene test of the variance).
+ *
+ * All functions return p-values; the seeds are fixed, so the outcome of a
+ * test is deterministic.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <ogdf/basic/basic.h>
+
+#include "../common/EdgeSink.h"
+
+namespace ogdf {
+namespace statistics {
+
+//! Returns the regularized upper incomplete gamma function Q(\p a, \p x).
+inline double upperGamma(double a, double x) {
+	if (x <= 0.0) return 1.0;
+
+	if (x < a + 1.0) {
+		// series of the lower function
+		double term = 1.0 / a, sum = term;
+		for (int k = 1; k < 1000 && term > sum * 1e-15; k++) {
+			term *= x / (a + k);
+			sum += term;
+		}
+		return 1.0 - sum * exp(-x + a * log(x) - lgamma(a));
+	}
+
+	// continued fraction of the upper function (modified Lentz)
+	double b = x + 1.0 - a, c = 1e300, d = 1.0 / b, h = d;
+	for (int k = 1; k < 1000; k++) {
+		double an = -k * (k - a);
+		b += 2.0;
+		d = an * d + b;
+		if (fabs(d) < 1e-300) d = 1e-300;
+		c = b + an / c;
+		if (fabs(c) < 1e-300) c = 1e-300;
+		d = 1.0 / d;
+		double delta = d * c;
+		h *= delta;
+		if (fabs(delta - 1.0) < 1e-15) break;
+	}
+	return exp(-x + a * log(x) - lgamma(a)) * h;
+}
+
+//! Returns the probability that a chi-square variable with \p df degrees of freedom exceeds \p x.
+inline double chiSquareTail(double x, int df) {
+	return df <= 0 ? 1.0 : upperGamma(0.5 * df, 0.5 * x);
+}
+
+//! Returns the two-sided p-value of a standard normal statistic \p z.
+inline double normalTwoSided(double z) {
+	return erfc(fabs(z) / sqrt(2.0));
+}
+
+//! Returns the p-value of the chi-square test that the histograms \p a and \p b stem from the same distribution.
+/**
+ * Adjacent bins are merged until every bin has an expected count of at
+ * least 5 in both samples.
+ */
+inline double chiSquareHomogeneity(const std::vector<long> &a, const std::vector<long> &b) {
+	size_t bins = std::max(a.size(), b.size());
+	double totalA = 0, totalB = 0;
+	for (size_t i = 0; i < bins; i++) {
+		totalA += i < a.size() ? a[i] : 0;
+		totalB += i < b.size() ? b[i] : 0;
+	}
+	if (totalA == 0 || totalB == 0) return 1.0;
+
+	std::vector<std::pair<double, double>> merged;
+	double countA = 0, countB = 0;
+	for (size_t i = 0; i < bins; i++) {
+		countA += i < a.size() ? a[i] : 0;
+		countB += i < b.size() ? b[i] : 0;
+		double expected = (countA + countB) * std::min(totalA, totalB) / (totalA + totalB);
+		if (expected >= 5.0) {
+			merged.emplace_back(countA, countB);
+			countA = countB = 0;
+		}
+	}
+	if (merged.empty()) return 1.0;
+	merged.back().first += countA;
+	merged.back().second += countB;
+
+	double chi = 0;
+	for (const auto &bin : merged) {
+		double row = bin.first + bin.second;
+		double expectedA = row * totalA / (totalA + totalB);
+		double expectedB = row * totalB / (totalA + totalB);
+		chi += (bin.first - expectedA) * (bin.first - expectedA) / expectedA;
+		chi += (bin.second - expectedB) * (bin.second - expectedB) / expectedB;
+	}
+	return chiSquareTail(chi, (int)merged.size() - 1);
+}
+
+//! Returns the p-value of the two-sample Kolmogorov-Smirnov test; conservative for discrete samples.
+inline double kolmogorovSmirnov(std::vector<double> a, std::vector<double> b) {
+	if (a.empty() || b.empty()) return 1.0;
+	std::sort(a.begin(), a.end());
+	std::sort(b.begin(), b.end());
+
+	double maxDifference = 0;
+	size_t i = 0, j = 0;
+	while (i < a.size() && j < b.size()) {
+		double x = std::min(a[i], b[j]);
+		while (i < a.size() && a[i] == x) i++;
+		while (j < b.size() && b[j] == x) j++;
+		maxDifference = std::max(maxDifference, fabs((double)i / a.size() - (double)j / b.size()));
+	}
+
+	double effective = sqrt((double)a.size() * b.size() / (a.size() + b.size()));
+	double lambda = (effective + 0.12 + 0.11 / effective) * maxDifference;
+
+	// Kolmogorov distribution
+	double p = 0;
+	for (int k = 1; k <= 100; k++) {
+		p += 2.0 * ((k % 2 == 1) ? 1.0 : -1.0) * exp(-2.0 * k * k * lambda * lambda);
+	}
+	return std::min(std::max(p, 0.0), 1.0);
+}
+
+//! Returns the p-value of the test that \p a and \p b have the same mean.
+inline double compareMeans(const std::vector<double> &a, const std::vector<double> &b) {
+	auto moments = [](const std::vector<double> &x) {
+		double mean = 0, variance = 0;
+		for (double v : x) mean += v;
+		mean /= x.size();
+		for (double v : x) variance += (v - mean) * (v - mean);
+		return std::make_pair(mean, variance / (x.size() - 1));
+	};
+	auto ma = moments(a), mb = moments(b);
+	double error = sqrt(ma.second / a.size() + mb.second / b.size());
+	if (error == 0) return ma.first == mb.first ? 1.0 : 0.0;
+	return normalTwoSided((ma.first - mb.first) / error);
+}
+
+//! Returns the p-value of Levene's test that \p a and \p b have the same variance.
+inline double compareVariances(const std::vector<double> &a, const std::vector<double> &b) {
+	auto deviations = [](const std::vector<double> &x) {
+		double mean = 0;
+		for (double v : x) mean += v;
+		mean /= x.size();
+		std::vector<double> result;
+		for (double v : x) result.push_back(fabs(v - mean));
+		return result;
+	};
+	return compareMeans(deviations(a), deviations(b));
+}
+
+
+//! Statistics of repeated runs of a generator on the same instance.
+struct GraphSamples {
+	int n = 0;
+	//! Number of samples containing each pair {u, v}, u < v, at index v*(v-1)/2 + u.
+	std::vector<long> pairCount;
+	//! Histogram of the degree of node (i mod n) in the i-th sample.
+	std::vector<long> degreeHistogram;
+	//! Number of edges of each sample.
+	std::vector<double> edges;
+};
+
+//! Runs \p generate, which writes a graph on \p n nodes into the given sink, \p samples times after setting \p seed.
+inline GraphSamples sampleGraphs(int n, int samples, int seed, const std::function<void(EdgeSink &)> &generate) {
+	GraphSamples result;
+	result.n = n;
+	result.pairCount.assign((size_t)n * (n - 1) / 2, 0);
+
+	setSeed(seed);
+	std::vector<std::pair<uint32_t, uint32_t>> edges;
+	std::vector<char> seen(result.pairCount.size());
+	for (int i = 0; i < samples; i++) {
+		edges.clear();
+		EdgeListSink sink(edges);
+		generate(sink);
+
+		int observed = i % n;
+		long degree = 0;
+		std::fill(seen.begin(), seen.end(), 0);
+		for (const auto &e : edges) {
+			uint32_t u = std::min(e.first, e.second), v = std::max(e.first, e.second);
+			if (u != v && !seen[(size_t)v * (v - 1) / 2 + u]) {
+				seen[(size_t)v * (v - 1) / 2 + u] = 1;
+				result.pairCount[(size_t)v * (v - 1) / 2 + u]++;
+			}
+			degree += (u == (uint32_t)observed) + (v == (uint32_t)observed);
+		}
+
+		if ((size_t)degree >= result.degreeHistogram.size()) {
+			result.degreeHistogram.resize(degree + 1, 0);
+		}
+		result.degreeHistogram[degree]++;
+		result.edges.push_back((double)edges.size());
+	}
+	return result;
+}
+
+//! Returns the Bonferroni-corrected p-value of the tests that every pair has the same marginal probability in \p a and \p b.
+inline double comparePairMarginals(const GraphSamples &a, const GraphSamples &b) {
+	double sizeA = (double)a.edges.size(), sizeB = (double)b.edges.size();
+	double minimum = 1.0;
+	for (size_t i = 0; i < a.pairCount.size(); i++) {
+		double pooled = (a.pairCount[i] + b.pairCount[i]) / (sizeA + sizeB);
+		double error = sqrt(pooled * (1.0 - pooled) * (1.0 / sizeA + 1.0 / sizeB));
+		if (error == 0) continue;
+		double z = (a.pairCount[i] / sizeA - b.pairCount[i] / sizeB) / error;
+		minimum = std::min(minimum, normalTwoSided(z));
+	}
+	return std::min(1.0, minimum * a.pairCount.size());
+}
+
+//! Returns the p-value of the chi-square test that the degree distributions of \p a and \p b are equal.
+inline double compareDegrees(const GraphSamples &a, const GraphSamples &b) {
+	return chiSquareHomogeneity(a.degreeHistogram, b.degreeHistogram);
+}
+
+//! Returns the p-value of the Kolmogorov-Smirnov test that the edge counts of \p a and \p b have the same distribution.
+inline double compareEdgeCounts(const GraphSamples &a, const GraphSamples &b) {
+	return kolmogorovSmirnov(a.edges, b.edges);
+}
+
+}
+}
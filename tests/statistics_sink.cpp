@@ -0,0 +1,102 @@
+#include "bandit/bandit.h"
+
+#include "../common/Generators.h"
+#include "../common/Random.h"
+#include "../common/StatisticsSink.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+//! Returns the number of triangles of the graph in \p csr, which must be simple.
+static long long countTriangles(const CsrSink &csr) {
+	long long triangles = 0;
+	std::vector<char> adjacent(csr.numberOfNodes(), 0);
+	for (int u = 0; u < csr.numberOfNodes(); u++) {
+		for (uint64_t i = csr.offsets()[u]; i < csr.offsets()[u + 1]; i++) {
+			adjacent[csr.targets()[i]] = 1;
+		}
+		for (uint64_t i = csr.offsets()[u]; i < csr.offsets()[u + 1]; i++) {
+			uint32_t v = csr.targets()[i];
+			for (uint64_t j = csr.offsets()[v]; j < csr.offsets()[v + 1]; j++) {
+				uint32_t w = csr.targets()[j];
+				if ((uint32_t)u < v && v < w && adjacent[w]) {
+					triangles++;
+				}
+			}
+		}
+		for (uint64_t i = csr.offsets()[u]; i < csr.offsets()[u + 1]; i++) {
+			adjacent[csr.targets()[i]] = 0;
+		}
+	}
+	return triangles;
+}
+
+go_bandit([](){
+	describe("StatisticsSink", [&](){
+		auto generate = [](EdgeSink &sink) { randomWattsStrogatzGraph(sink, 3000, 10, 0.1); };
+
+		CsrSink csr;
+		StatisticsSink exact(1.0);
+		{
+			SeedScope scope(5);
+			generate(csr);
+		}
+		{
+			SeedScope scope(5);
+			generate(exact);
+		}
+
+		it("counts the nodes, edges and degrees of the generated graph", [&](){
+			AssertThat(exact.numberOfNodes(), Equals(csr.numberOfNodes()));
+			AssertThat((uint64_t)exact.numberOfEdges(), Equals(csr.numberOfEdges()));
+			std::vector<long long> histogram(exact.maxDegree() + 1, 0);
+			for (int v = 0; v < csr.numberOfNodes(); v++) {
+				AssertThat((uint64_t)exact.degree(v), Equals(csr.degree(v)));
+				histogram[csr.degree(v)]++;
+			}
+			AssertThat(exact.degreeHistogram() == histogram, IsTrue());
+			AssertThat(exact.averageDegree(), Equals(2.0 * csr.numberOfEdges() / csr.numberOfNodes()));
+		});
+
+		it("counts the triangles exactly with sample probability one", [&](){
+			AssertThat(exact.triangles(), Equals((double)countTriangles(csr)));
+			AssertThat(exact.clustering(), IsGreaterThan(0.3));
+		});
+
+		it("estimates the triangles from a sample", [&](){
+			double triangles = (double)countTriangles(csr);
+			double sum = 0.0;
+			for (uint64_t seed = 1; seed <= 20; seed++) {
+				StatisticsSink sampled(0.5, seed);
+				SeedScope scope(5);
+				generate(sampled);
+				sum += sampled.triangles();
+			}
+			AssertThat(0.05 * triangles, IsGreaterThan(std::fabs(sum / 20 - triangles)));
+		});
+
+		it("accumulates the costs of the edges", [&](){
+			StatisticsSink statistics;
+			{
+				SeedScope scope(6);
+				randomWaxmanGraphUsingPlane(statistics, 300, 0.5, 0.2);
+			}
+			AssertThat(statistics.numberOfCosts(), Equals(statistics.numberOfEdges()));
+			AssertThat(statistics.minCost(), IsGreaterThan(0.0));
+			AssertThat(statistics.averageCost(), IsGreaterThan(statistics.minCost()));
+			AssertThat(std::sqrt(2.0), IsGreaterThan(statistics.maxCost()));
+			AssertThat(statistics.triangles(), Equals(0.0));
+		});
+
+		it("calibrates the threshold of a random geometric graph", [&](){
+			// on the torus, a node has (n - 1) pi r^2 neighbors on average
+			for (double threshold : {0.02, 0.05}) {
+				StatisticsSink statistics;
+				SeedScope scope(7);
+				randomGeometricTorusGraph(statistics, 4000, threshold);
+				double expected = 3999 * M_PI * threshold * threshold;
+				AssertThat(0.05 * expected, IsGreaterThan(std::fabs(statistics.averageDegree() - expected)));
+			}
+		});
+	});
+});
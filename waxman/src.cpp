@@ -25,71 +25,512 @@
 
 #include <iostream>
 #include <cmath>
+#include <cstdlib>
 #include <random>
+#include <algorithm>
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/NodeArray.h>
+#include <ogdf/basic/EdgeArray.h>
 #include <ogdf/basic/geometry.h>
 
-using std::minstd_rand;
+#include "../common/BatchRandom.h"
+#include "../common/Generators.h"
+#include "../common/GeneratorStats.h"
+#include "../common/Random.h"
+#include "../common/Shard.h"
+#include "../common/SpaceFillingCurve.h"
+
 using std::uniform_int_distribution;
 using std::uniform_real_distribution;
 using namespace ogdf;
 
+//! Returns true if \p alpha and \p beta are in the range (0, 1].
+static bool validParameters(double alpha, double beta) {
+	return alpha > 0.0 && (alpha < (1.0 + std::numeric_limits<double>::epsilon()))
+	    && beta > 0.0 && (beta < (1.0 + std::numeric_limits<double>::epsilon()));
+}
+
+//! Returns the maximum distance between two of the given points.
+/**
+ * Only points on the convex hull can realize the maximum, so it suffices
+ * to compare the hull points pairwise after an O(n log n) hull computation.
+ */
+static double maxPointDistance(const Array<DPoint> &points) {
+	Array<DPoint> sorted(points.size());
+	for (int i = 0; i < points.size(); i++) {
+		sorted[i] = points[i];
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const DPoint &p, const DPoint &q) {
+		return p.m_x < q.m_x || (p.m_x == q.m_x && p.m_y < q.m_y);
+	});
+
+	auto cross = [](const DPoint &o, const DPoint &p, const DPoint &q) {
+		return (p.m_x - o.m_x) * (q.m_y - o.m_y) - (p.m_y - o.m_y) * (q.m_x - o.m_x);
+	};
+
+	// Andrew's monotone chain, lower hull followed by upper hull
+	Array<DPoint> hull(2 * sorted.size());
+	int h = 0;
+	for (int i = 0; i < sorted.size(); i++) {
+		while (h >= 2 && cross(hull[h - 2], hull[h - 1], sorted[i]) <= 0) h--;
+		hull[h++] = sorted[i];
+	}
+	for (int i = sorted.size() - 2, lower = h + 1; i >= 0; i--) {
+		while (h >= lower && cross(hull[h - 2], hull[h - 1], sorted[i]) <= 0) h--;
+		hull[h++] = sorted[i];
+	}
+
+	double maxDistance = 0.0;
+	for (int i = 0; i < h; i++) {
+		for (int j = i + 1; j < h; j++) {
+			maxDistance = std::max(maxDistance, hull[i].distance(hull[j]));
+		}
+	}
+
+	return maxDistance;
+}
+
 //! Creates a Waxman graph[Model-1] by laying out nodes in a unit square.
 /**
- * @param G is assigned the generated graph.
+ * The cost of each edge is the distance between its endpoints.
+ *
+ * @param sink is assigned the generated graph.
  * @param n is the number of nodes of the generated graph.
  * @param alpha is a parameter in the range(0, 1].
  * @param beta is a parameter in the range(0, 1].
+ * @param order is the order in which the points are numbered.
  */
-void randomWaxmanGraphUsingPlane(Graph &G, int n, double alpha, double beta) {
+void randomWaxmanGraphUsingPlane(EdgeSink &sink, int n, double alpha, double beta, NodeOrder order) {
 	OGDF_ASSERT(n >= 0);
-	OGDF_ASSERT(alpha > 0.0 && (alpha < (1.0 + std::numeric_limits<double>::epsilon())));
-	OGDF_ASSERT(beta > 0.0 && (beta < (1.0 + std::numeric_limits<double>::epsilon())));
 
-	G.clear();
-	if (n == 0) return;
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(alpha, beta)) {
+		sink.finish();
+		return;
+	}
 
-	minstd_rand rng(randomSeed());
-	uniform_real_distribution<> dist(0, 1);
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
+	BatchRandom pointRandom(seed, 0, 0);
 
-	NodeArray<DPoint> point(G, DPoint(0, 0));
+	Array<DPoint> point(n);
 
 	// adding n nodes to graph
+	sink.reserve(n, 0);
 	for (int i = 0; i < n; i++) {
-		G.newNode();
+		sink.addNode();
 	}
 
 	// setting random points in the plane
-	for (node v : G.nodes) {
-		point[v] = DPoint(dist(rng), dist(rng));
+	for (int v = 0; v < n; v++) {
+		point[v] = DPoint(pointRandom.next(), pointRandom.next());
 	}
 
-	double maxDistance = 0.0;
+	// numbering the points along a space-filling curve
+	if (order != NodeOrder::Random) {
+		applyCurveOrder(&point[0], 1, curveOrder(n, 2, order, [&](int v, int i) { return i == 0 ? point[v].m_x : point[v].m_y; }));
+	}
+
+	// reporting the positions of the nodes
+	for (int v = 0; v < n; v++) {
+		double position[2] = {point[v].m_x, point[v].m_y};
+		sink.setPosition(v, position, 2);
+	}
 
 	// obtaining maximum distance between points
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
+	double maxDistance = maxPointDistance(point);
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	// the pairs {v, w}, w > v, are decided by block v of stream 1
+	for (int v = rows.first; v < rows.second; v++) {
+		BatchRandom random(seed, 1, v);
+		probe.pairs(n - v - 1);
+		for (int w = v + 1; w < n; w++) {
 			double distance = point[v].distance(point[w]);
-			if (distance > maxDistance) {
-				maxDistance = distance;
+			double probability = alpha * exp(-distance / (beta * maxDistance));
+
+			// connecting nodes based on probability
+			if (random.next() < (probability + std::numeric_limits<double>::epsilon())) {
+				sink.addEdge(v, w, distance);
+				probe.edges();
 			}
 		}
 	}
 
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Waxman graph[Model-1] by laying out nodes in a unit square.
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param order is the order in which the points are numbered.
+ */
+void randomWaxmanGraphUsingPlane(Graph &G, int n, double alpha, double beta, NodeOrder order) {
+	G.clear();
+	GraphSink sink(G);
+	randomWaxmanGraphUsingPlane(sink, n, alpha, beta, order);
+}
+
+//! Creates a Waxman graph[Model-1] by laying out nodes in a unit square and assigns positions and edge costs.
+/**
+ * @param G is assigned the generated graph.
+ * @param GA is assigned the positions of the nodes; it must belong to \p G.
+ * @param distance is assigned the distance between the endpoints of each edge.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param order is the order in which the points are numbered.
+ */
+void randomWaxmanGraphUsingPlane(Graph &G, GraphAttributes &GA, EdgeArray<double> &distance, int n, double alpha, double beta, NodeOrder order) {
+	G.clear();
+	GraphSink sink(G, &distance, &GA);
+	randomWaxmanGraphUsingPlane(sink, n, alpha, beta, order);
+}
+
+//! Returns the logarithm of 1 - \p probability, the base of the geometric skips, or 0 if no pair can be chosen.
+/**
+ * log1p keeps probabilities below the machine epsilon, e.g. the far bands
+ * of a small beta, from rounding to log(1) = 0.
+ */
+static double skipBase(double probability) {
+	if (!(probability > 0.0)) return 0.0;
+	return log1p(-std::min(probability, 1.0));
+}
+
+//! Calls \p emit(v, w) for each pair w < v < \p n chosen independently with \p probability.
+/**
+ * Uses geometric skipping over the pairs in lexicographical order, so that
+ * the running time is linear in the number of chosen pairs plus \p n. Skips
+ * are compared with the number of remaining pairs before they are
+ * converted to integers, since they are unbounded for tiny probabilities.
+ */
+template<typename Emit>
+static void skipPairs(int n, double probability, RandomEngine &rng, Emit emit) {
+	double logq = skipBase(probability);
+	long long remaining = (long long)n * (n - 1) / 2;
+	if (logq == 0.0 || remaining == 0) return;
+
+	uniform_real_distribution<> dist(0, 1);
+	int v = 1;
+	long long w = -1;
+
+	for (;;) {
+		double skip = floor(log(1.0 - dist(rng)) / logq);
+		if (skip >= (double)remaining) break;
+		remaining -= 1 + (long long)skip;
+		w += 1 + (long long)skip;
+		while (w >= v) {
+			w -= v;
+			v++;
+		}
+		emit(v, (int)w);
+	}
+}
+
+//! Calls \p emit(a, b) for each pair in [0, \p rows) x [0, \p cols) chosen independently with \p probability.
+template<typename Emit>
+static void skipRectangle(int rows, int cols, double probability, RandomEngine &rng, Emit emit) {
+	double logq = skipBase(probability);
+	long long total = (long long)rows * cols;
+	if (logq == 0.0 || total == 0) return;
+
+	uniform_real_distribution<> dist(0, 1);
+
+	for (long long t = -1;;) {
+		double skip = floor(log(1.0 - dist(rng)) / logq);
+		if (skip >= (double)(total - t - 1)) break;
+		t += 1 + (long long)skip;
+		emit((int)(t / cols), (int)(t % cols));
+	}
+}
+
+//! Creates a Waxman graph[Model-1] in a unit square in time roughly linear in its size.
+/**
+ * Samples the same distribution as randomWaxmanGraphUsingPlane(). The points
+ * are bucketed into a grid whose cells are at most beta * maxDistance wide,
+ * unless that would make more than about n / 2 cells, in which case there
+ * are about n / 2 wider cells. Cell pairs are visited in rings of
+ * increasing offset; in each of them the probability of the closest
+ * possible pair bounds all of its pairs, so candidates are sampled by
+ * geometric skipping and accepted with the exact ratio. Pairs beyond the
+ * last ring are handled by a single skipping pass with a global bound
+ * chosen such that only O(n) candidates are expected.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param order is the order in which the points are numbered.
+ */
+void randomWaxmanGraphUsingPlaneFast(EdgeSink &sink, int n, double alpha, double beta, NodeOrder order) {
+	OGDF_ASSERT(n >= 0);
+
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(alpha, beta)) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	RandomEngine rng(generatorSeed());
+	uniform_real_distribution<> dist(0, 1);
+
+	Array<DPoint> point(n);
+
+	// adding n nodes to graph
+	sink.reserve(n, 0);
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
+	}
+
+	// setting random points in the plane
+	for (int i = 0; i < n; i++) {
+		// drawing x before y, since the order of evaluating arguments is unspecified
+		double x = dist(rng);
+		double y = dist(rng);
+		point[i] = DPoint(x, y);
+	}
+
+	// numbering the points along a space-filling curve
+	if (order != NodeOrder::Random) {
+		applyCurveOrder(&point[0], 1, curveOrder(n, 2, order, [&](int v, int i) { return i == 0 ? point[v].m_x : point[v].m_y; }));
+	}
+
+	// reporting the positions of the nodes
+	for (int v = 0; v < n; v++) {
+		double position[2] = {point[v].m_x, point[v].m_y};
+		sink.setPosition(v, position, 2);
+	}
+
+	if (n < 2) {
+		sink.finish();
+		return;
+	}
+
+	double scale = beta * maxPointDistance(point);
+
+	// cells are at most scale wide, unless there would be more than about n / 2 of them
+	int k = std::max(1, (int)std::min(ceil(1.0 / scale), ceil(sqrt(n / 2.0))));
+
+	// after ring R all pairs have probability at most alpha * exp(-R / (k * scale))
+	int R = k - 1;
+	double farProbability = 0.0;
+	if (alpha * n / 2 > 1.0) {
+		R = (int)std::min((double)(k - 1), ceil(k * scale * log(alpha * n / 2)));
+		farProbability = alpha * exp(-R / (k * scale));
+	}
+
+	// bucketing points into cells
+	Array<int> cell(n);
+	Array<int> cellStart(0, k * k, 0);
+	for (int i = 0; i < n; i++) {
+		int cx = std::min((int)(point[i].m_x * k), k - 1);
+		int cy = std::min((int)(point[i].m_y * k), k - 1);
+		cell[i] = cy * k + cx;
+		cellStart[cell[i] + 1]++;
+	}
+	for (int c = 0; c < k * k; c++) {
+		cellStart[c + 1] += cellStart[c];
+	}
+
+	Array<int> cellNodes(n);
+	Array<int> fill(k * k);
+	Array<int> occupied(k * k);
+	int numOccupied = 0;
+	for (int c = 0; c < k * k; c++) {
+		fill[c] = cellStart[c];
+		if (cellStart[c + 1] > cellStart[c]) {
+			occupied[numOccupied++] = c;
+		}
+	}
+	for (int i = 0; i < n; i++) {
+		cellNodes[fill[cell[i]]++] = i;
+	}
+
+	auto tryEdge = [&](int i, int j, double bound) {
+		double distance = point[i].distance(point[j]);
+		double probability = alpha * exp(-distance / scale);
+
+		// accepting the candidate with the ratio of its probability and the bound
+		probe.pairs();
+		if (dist(rng) * bound < probability) {
+			sink.addEdge(std::min(i, j), std::max(i, j), distance);
+			probe.edges();
+		} else {
+			probe.rejections();
+		}
+	};
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	// visiting cell pairs in rings of increasing offset
+	for (int ring = 0; ring <= R; ring++) {
+		for (int dy = 0; dy <= ring; dy++) {
+			for (int dx = -ring; dx <= ring; dx++) {
+				if (std::max(abs(dx), dy) != ring || (dy == 0 && dx < 0)) continue;
+
+				double gapX = std::max(abs(dx) - 1, 0) / (double)k;
+				double gapY = std::max(dy - 1, 0) / (double)k;
+				double bound = std::min(alpha * exp(-sqrt(gapX * gapX + gapY * gapY) / scale), 1.0);
+
+				for (int o = 0; o < numOccupied; o++) {
+					int c = occupied[o];
+					int ax = c % k + dx, ay = c / k + dy;
+					if (ax < 0 || ax >= k || ay >= k) continue;
+
+					int first = cellStart[c], size = cellStart[c + 1] - first;
+
+					if (ring == 0) {
+						skipPairs(size, bound, rng, [&](int a, int b) {
+							tryEdge(cellNodes[first + a], cellNodes[first + b], bound);
+						});
+					} else {
+						int d = ay * k + ax;
+						int other = cellStart[d], otherSize = cellStart[d + 1] - other;
+						skipRectangle(size, otherSize, bound, rng, [&](int a, int b) {
+							tryEdge(cellNodes[first + a], cellNodes[other + b], bound);
+						});
+					}
+				}
+			}
+		}
+	}
+
+	// pairs of cells beyond the last ring share the far bound
+	if (R < k - 1) {
+		skipPairs(n, farProbability, rng, [&](int i, int j) {
+			int offset = std::max(abs(cell[i] % k - cell[j] % k), abs(cell[i] / k - cell[j] / k));
+			if (offset > R) {
+				tryEdge(i, j, farProbability);
+			}
+		});
+	}
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Waxman graph[Model-1] in a unit square in time roughly linear in its size.
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param order is the order in which the points are numbered.
+ */
+void randomWaxmanGraphUsingPlaneFast(Graph &G, int n, double alpha, double beta, NodeOrder order) {
+	G.clear();
+	GraphSink sink(G);
+	randomWaxmanGraphUsingPlaneFast(sink, n, alpha, beta, order);
+}
+
+//! Creates a Waxman graph[Model-1] in a unit square in time roughly linear in its size and assigns positions and edge costs.
+/**
+ * @param G is assigned the generated graph.
+ * @param GA is assigned the positions of the nodes; it must belong to \p G.
+ * @param distance is assigned the distance between the endpoints of each edge.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param order is the order in which the points are numbered.
+ */
+void randomWaxmanGraphUsingPlaneFast(Graph &G, GraphAttributes &GA, EdgeArray<double> &distance, int n, double alpha, double beta, NodeOrder order) {
+	G.clear();
+	GraphSink sink(G, &distance, &GA);
+	randomWaxmanGraphUsingPlaneFast(sink, n, alpha, beta, order);
+}
+
+//! Tests every pair {v, w}, v in [\p rows.first, \p rows.second), w > v, of the grid points \p point.
+/**
+ * The pairs of v are decided by block v of stream 1 of \p seed, and every
+ * edge is written to \p sink with its length as cost.
+ */
+static void connectGridPairs(EdgeSink &sink, const Array<DPoint> &point, std::pair<int, int> rows, uint64_t seed,
+		double alpha, double beta, double maxDistance, GeneratorProbe &probe) {
+	int n = point.size();
+	for (int v = rows.first; v < rows.second; v++) {
+		BatchRandom random(seed, 1, v);
+		probe.pairs(n - v - 1);
+		for (int w = v + 1; w < n; w++) {
 			double distance = point[v].distance(point[w]);
-			double probability = alpha * exp(-distance / (beta * maxDistance));
+			double probability = maxDistance == 0.0 ? alpha : alpha * exp(-distance / (beta * maxDistance));
 
 			// connecting nodes based on probability
-			if (dist(rng) < (probability + std::numeric_limits<double>::epsilon())) {
-				G.newEdge(v, w);
+			if (random.next() < (probability + std::numeric_limits<double>::epsilon())) {
+				sink.addEdge(v, w, distance);
+				probe.edges();
 			}
 		}
 	}
+}
+
+//! Creates a Waxman graph[Model-1] by laying out nodes in a user specified grid.
+/**
+ * The cost of each edge is the distance between its endpoints.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param width is the width of the grid.
+ * @param height is the height of the grid.
+ * @param order is the order in which the points are numbered.
+ */
+void randomWaxmanGraphUsingGrid(EdgeSink &sink, int n, double alpha, double beta, int width, int height, NodeOrder order) {
+	OGDF_ASSERT(n >= 0 && width >= 0 && height >= 0);
+
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(alpha, beta)) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
+	RandomEngine rng(seed);
+	uniform_int_distribution<> distx(0, width);
+	uniform_int_distribution<> disty(0, height);
+
+	Array<DPoint> point(n);
+
+	// adding n nodes to graph
+	sink.reserve(n, 0);
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
+	}
+
+	// setting random points in the width*height grid.
+	for (int v = 0; v < n; v++) {
+		// drawing x before y, since the order of evaluating arguments is unspecified
+		int x = distx(rng);
+		int y = disty(rng);
+		point[v] = DPoint(x, y);
+	}
+
+	// numbering the points along a space-filling curve
+	if (order != NodeOrder::Random) {
+		applyCurveOrder(&point[0], 1, curveOrder(n, 2, order, [&](int v, int i) { return i == 0 ? point[v].m_x : point[v].m_y; }));
+	}
 
+	// reporting the positions of the nodes
+	for (int v = 0; v < n; v++) {
+		double position[2] = {point[v].m_x, point[v].m_y};
+		sink.setPosition(v, position, 2);
+	}
+
+	// obtaining maximum distance between points
+	double maxDistance = maxPointDistance(point);
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	connectGridPairs(sink, point, shardRows(n), seed, alpha, beta, maxDistance, probe);
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
 }
 
 //! Creates a Waxman graph[Model-1] by laying out nodes in a user specified grid.
@@ -100,133 +541,512 @@ void randomWaxmanGraphUsingPlane(Graph &G, int n, double alpha, double beta) {
  * @param beta is a parameter in the range(0, 1].
  * @param width is the width of the grid.
  * @param height is the height of the grid.
+ * @param order is the order in which the points are numbered.
  */
-void randomWaxmanGraphUsingGrid(Graph &G, int n, double alpha, double beta, int width, int height) {
-	OGDF_ASSERT(n >= 0 && width >= 0 && height >= 0);
-	OGDF_ASSERT(alpha > 0.0 && (alpha < (1.0 + std::numeric_limits<double>::epsilon())));
-	OGDF_ASSERT(beta > 0.0 && (beta < (1.0 + std::numeric_limits<double>::epsilon())));
+void randomWaxmanGraphUsingGrid(Graph &G, int n, double alpha, double beta, int width, int height, NodeOrder order) {
+	G.clear();
+	GraphSink sink(G);
+	randomWaxmanGraphUsingGrid(sink, n, alpha, beta, width, height, order);
+}
 
+//! Creates a Waxman graph[Model-1] by laying out nodes in a user specified grid and assigns positions and edge costs.
+/**
+ * @param G is assigned the generated graph.
+ * @param GA is assigned the positions of the nodes; it must belong to \p G.
+ * @param distance is assigned the distance between the endpoints of each edge.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param width is the width of the grid.
+ * @param height is the height of the grid.
+ * @param order is the order in which the points are numbered.
+ */
+void randomWaxmanGraphUsingGrid(Graph &G, GraphAttributes &GA, EdgeArray<double> &distance, int n, double alpha, double beta, int width, int height, NodeOrder order) {
 	G.clear();
-	if (n == 0) return;
+	GraphSink sink(G, &distance, &GA);
+	randomWaxmanGraphUsingGrid(sink, n, alpha, beta, width, height, order);
+}
 
-	minstd_rand rng(randomSeed());
-	uniform_real_distribution<> dist(0, 1);
+//! Creates a Waxman graph[Model-1] in a user specified grid by bucketing nodes with equal coordinates.
+/**
+ * Samples the same distribution as randomWaxmanGraphUsingGrid(). Since nodes
+ * only occupy integer coordinates, all pairs of nodes in the same two grid
+ * points share their edge probability. The probability is precomputed for
+ * every integer offset (dx, dy), and the node pairs of every two occupied
+ * grid points are chosen by geometric skipping, which draws their binomial
+ * number of edges together with the chosen pairs, in increasing order. This
+ * pays off when n is large compared to the number of grid points; if at
+ * least half of the nodes have a grid point of their own, the node pairs are
+ * tested one by one as in randomWaxmanGraphUsingGrid(), which then yields
+ * the same graph for the same seed.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param width is the width of the grid.
+ * @param height is the height of the grid.
+ * @param order is the order in which the points are numbered.
+ */
+void randomWaxmanGraphUsingGridFast(EdgeSink &sink, int n, double alpha, double beta, int width, int height, NodeOrder order) {
+	OGDF_ASSERT(n >= 0 && width >= 0 && height >= 0);
+
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(alpha, beta)) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
+	RandomEngine rng(seed);
 	uniform_int_distribution<> distx(0, width);
 	uniform_int_distribution<> disty(0, height);
 
-	NodeArray<DPoint> point(G, DPoint(0, 0));
+	// grid points are numbered row by row, which needs 64 bits for large grids
+	Array<long long> cell(n);
+	long long columns = (long long)width + 1;
+	long long cells = columns * ((long long)height + 1);
 
 	// adding n nodes to graph
+	sink.reserve(n, 0);
 	for (int i = 0; i < n; i++) {
-		G.newNode();
+		sink.addNode();
 	}
 
 	// setting random points in the width*height grid.
-	for (node v : G.nodes) {
-		point[v] = DPoint(distx(rng), disty(rng));
+	for (int i = 0; i < n; i++) {
+		long long x = distx(rng);
+		long long y = disty(rng);
+		cell[i] = y * columns + x;
 	}
 
-	double maxDistance = 0.0;
+	// numbering the points along a space-filling curve
+	if (order != NodeOrder::Random) {
+		applyCurveOrder(&cell[0], 1, curveOrder(n, 2, order, [&](int v, int i) { return (double)(i == 0 ? cell[v] % columns : cell[v] / columns); }));
+	}
 
-	// obtaining maximum distance between points
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
-			double distance = point[v].distance(point[w]);
-			if (distance > maxDistance) {
-				maxDistance = distance;
+	// reporting the positions of the nodes
+	for (int v = 0; v < n; v++) {
+		double position[2] = {(double)(cell[v] % columns), (double)(cell[v] / columns)};
+		sink.setPosition(v, position, 2);
+	}
+
+	// bucketing nodes by grid point, occupied grid points in increasing order
+	Array<int> sorted(n);
+	for (int i = 0; i < n; i++) {
+		sorted[i] = i;
+	}
+	std::sort(sorted.begin(), sorted.end(), [&](int i, int j) {
+		return cell[i] < cell[j];
+	});
+
+	Array<long long> occupied(n);
+	Array<int> start(n + 1);
+	int numOccupied = 0;
+	for (int i = 0; i < n; i++) {
+		if (i == 0 || cell[sorted[i]] != cell[sorted[i - 1]]) {
+			occupied[numOccupied] = cell[sorted[i]];
+			start[numOccupied++] = i;
+		}
+	}
+	start[numOccupied] = n;
+
+	Array<DPoint> point(numOccupied);
+	for (int c = 0; c < numOccupied; c++) {
+		point[c] = DPoint((double)(occupied[c] % columns), (double)(occupied[c] / columns));
+	}
+
+	double maxDistance = maxPointDistance(point);
+
+	// with few collisions, the pairs of grid points are hardly fewer than the pairs of nodes
+	if (2 * numOccupied > n) {
+		Array<DPoint> nodePoint(n);
+		for (int v = 0; v < n; v++) {
+			nodePoint[v] = DPoint((double)(cell[v] % columns), (double)(cell[v] / columns));
+		}
+
+		probe.phase(GeneratorStats::Phase::Edges);
+		connectGridPairs(sink, nodePoint, {0, n}, seed, alpha, beta, maxDistance, probe);
+
+		probe.phase(GeneratorStats::Phase::Finish);
+		sink.finish();
+		return;
+	}
+
+	auto distanceOf = [](long long dx, long long dy) {
+		return sqrt((double)dx * dx + (double)dy * dy);
+	};
+
+	// edge probability for each integer offset, if the table is not much larger than the input
+	auto probabilityOf = [&](long long dx, long long dy) {
+		double distance = distanceOf(dx, dy);
+		return maxDistance == 0.0 ? alpha : alpha * exp(-distance / (beta * maxDistance));
+	};
+
+	bool useTable = cells <= std::max(4LL * n, 1LL << 16);
+	Array<double> table(useTable ? (int)cells : 0);
+	if (useTable) {
+		for (int dy = 0; dy <= height; dy++) {
+			for (int dx = 0; dx <= width; dx++) {
+				table[(int)(dy * columns + dx)] = probabilityOf(dx, dy);
 			}
 		}
 	}
 
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
-			double distance = point[v].distance(point[w]);
-			double probability = alpha * exp(-distance / (beta * maxDistance));
+	probe.phase(GeneratorStats::Phase::Edges);
+	for (int a = 0; a < numOccupied; a++) {
+		int first = start[a], size = start[a + 1] - first;
 
-			// connecting nodes based on probability
-			if (dist(rng) < (probability + std::numeric_limits<double>::epsilon())) {
-				G.newEdge(v, w);
+		for (int b = a; b < numOccupied; b++) {
+			long long dx = std::abs(occupied[a] % columns - occupied[b] % columns);
+			long long dy = std::abs(occupied[a] / columns - occupied[b] / columns);
+			double probability = std::min(useTable ? table[(int)(dy * columns + dx)] : probabilityOf(dx, dy), 1.0);
+			double distance = distanceOf(dx, dy);
+			probe.pairs();
+
+			auto emit = [&](int u, int v) {
+				sink.addEdge(std::min(u, v), std::max(u, v), distance);
+				probe.edges();
+			};
+			if (a == b) {
+				skipPairs(size, probability, rng, [&](int i, int j) { emit(sorted[first + i], sorted[first + j]); });
+			} else {
+				int other = start[b], otherSize = start[b + 1] - other;
+				skipRectangle(size, otherSize, probability, rng, [&](int i, int j) { emit(sorted[first + i], sorted[other + j]); });
 			}
 		}
 	}
 
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
 }
 
-//! Creates a Waxman graph[Model-2].
+//! Creates a Waxman graph[Model-1] in a user specified grid by bucketing nodes with equal coordinates.
 /**
  * @param G is assigned the generated graph.
  * @param n is the number of nodes of the generated graph.
  * @param alpha is a parameter in the range(0, 1].
  * @param beta is a parameter in the range(0, 1].
+ * @param width is the width of the grid.
+ * @param height is the height of the grid.
+ * @param order is the order in which the points are numbered.
  */
-void randomWaxmanGraph(Graph &G, int n, double alpha, double beta) {
-	OGDF_ASSERT(n >= 0);
-	OGDF_ASSERT(alpha > 0.0 && (alpha < (1.0 + std::numeric_limits<double>::epsilon())));
-	OGDF_ASSERT(beta > 0.0 && (beta < (1.0 + std::numeric_limits<double>::epsilon())));
+void randomWaxmanGraphUsingGridFast(Graph &G, int n, double alpha, double beta, int width, int height, NodeOrder order) {
+	G.clear();
+	GraphSink sink(G);
+	randomWaxmanGraphUsingGridFast(sink, n, alpha, beta, width, height, order);
+}
 
+//! Creates a Waxman graph[Model-1] in a user specified grid by bucketing nodes with equal coordinates and assigns positions and edge costs.
+/**
+ * @param G is assigned the generated graph.
+ * @param GA is assigned the positions of the nodes; it must belong to \p G.
+ * @param distance is assigned the distance between the endpoints of each edge.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param width is the width of the grid.
+ * @param height is the height of the grid.
+ * @param order is the order in which the points are numbered.
+ */
+void randomWaxmanGraphUsingGridFast(Graph &G, GraphAttributes &GA, EdgeArray<double> &distance, int n, double alpha, double beta, int width, int height, NodeOrder order) {
 	G.clear();
-	if (n == 0) return;
+	GraphSink sink(G, &distance, &GA);
+	randomWaxmanGraphUsingGridFast(sink, n, alpha, beta, width, height, order);
+}
 
-	minstd_rand rng(randomSeed());
-	uniform_real_distribution<> dist(0, 1);
+//! Creates a Waxman graph[Model-2].
+/**
+ * The cost of each edge is the distance chosen for its endpoints.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ */
+void randomWaxmanGraph(EdgeSink &sink, int n, double alpha, double beta) {
+	OGDF_ASSERT(n >= 0);
+
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(alpha, beta)) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
 
 	// adding n nodes to graph
+	sink.reserve(n, 0);
 	for (int i = 0; i < n; i++) {
-		G.newNode();
+		sink.addNode();
 	}
 
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
-			double probability = alpha * exp(-dist(rng) / beta);
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	// the pairs {v, w}, w > v, are decided by block v of stream 1
+	for (int v = rows.first; v < rows.second; v++) {
+		BatchRandom random(seed, 1, v);
+		probe.pairs(n - v - 1);
+		for (int w = v + 1; w < n; w++) {
+			double distance = random.next();
+			double probability = alpha * exp(-distance / beta);
 
 			// connecting nodes based on probability
-			if (dist(rng) < (probability + std::numeric_limits<double>::epsilon())) {
-				G.newEdge(v, w);
+			if (random.next() < (probability + std::numeric_limits<double>::epsilon())) {
+				sink.addEdge(v, w, distance);
+				probe.edges();
 			}
 		}
 	}
 
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
 }
 
-//! Creates a Waxman graph[Model-2] with user specified maxDistance.
+//! Creates a Waxman graph[Model-2].
 /**
  * @param G is assigned the generated graph.
  * @param n is the number of nodes of the generated graph.
  * @param alpha is a parameter in the range(0, 1].
  * @param beta is a parameter in the range(0, 1].
+ */
+void randomWaxmanGraph(Graph &G, int n, double alpha, double beta) {
+	G.clear();
+	GraphSink sink(G);
+	randomWaxmanGraph(sink, n, alpha, beta);
+}
+
+//! Creates a Waxman graph[Model-2] with user specified maxDistance.
+/**
+ * The cost of each edge is the distance chosen for its endpoints.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
  * @param maxDistance is the maximum distance between two nodes.
  */
-void randomWaxmanGraphIntegral(Graph &G, int n, double alpha, double beta, int maxDistance) {
-	OGDF_ASSERT(n >= 0 && maxDistance >= 0)
-	OGDF_ASSERT(alpha > 0.0 && (alpha < (1.0 + std::numeric_limits<double>::epsilon())));
-	OGDF_ASSERT(beta > 0.0 && (beta < (1.0 + std::numeric_limits<double>::epsilon())));
+void randomWaxmanGraphIntegral(EdgeSink &sink, int n, double alpha, double beta, int maxDistance) {
+	OGDF_ASSERT(n >= 0 && maxDistance >= 0);
 
-	G.clear();
-	if (n == 0) return;
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(alpha, beta)) {
+		sink.finish();
+		return;
+	}
 
-	minstd_rand rng(randomSeed());
+	GeneratorProbe probe;
+	uint64_t seed = generatorSeed();
 	// Distance between nodes is integral.
-	uniform_int_distribution<> dist(0, maxDistance);
+	uniform_int_distribution<> distDistance(0, maxDistance);
 
 	// adding n nodes to graph
+	sink.reserve(n, 0);
 	for (int i = 0; i < n; i++) {
-		G.newNode();
+		sink.addNode();
 	}
 
-	for (node v : G.nodes) {
-		for (node w = v->succ(); w; w = w->succ()) {
-			int distance = dist(rng);
-			double probability = alpha * exp(-distance / (beta * maxDistance));
+	probe.phase(GeneratorStats::Phase::Edges);
+	std::pair<int, int> rows = shardRows(n);
+	// the pairs {v, w}, w > v, are decided by block v of streams 1 and 2
+	for (int v = rows.first; v < rows.second; v++) {
+		BatchRandom random(seed, 1, v);
+		CounterStream distances(seed, 2, v);
+		probe.pairs(n - v - 1);
+		for (int w = v + 1; w < n; w++) {
+			int distance = distDistance(distances);
+			double probability = maxDistance == 0 ? alpha : alpha * exp(-distance / (beta * maxDistance));
 
 			// connecting nodes based on probability
-			if (dist(rng) < (probability + std::numeric_limits<double>::epsilon())) {
-				G.newEdge(v, w);
+			if (random.next() < (probability + std::numeric_limits<double>::epsilon())) {
+				sink.addEdge(v, w, distance);
+				probe.edges();
 			}
 		}
 	}
 
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Waxman graph[Model-2] with user specified maxDistance.
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param maxDistance is the maximum distance between two nodes.
+ */
+void randomWaxmanGraphIntegral(Graph &G, int n, double alpha, double beta, int maxDistance) {
+	G.clear();
+	GraphSink sink(G);
+	randomWaxmanGraphIntegral(sink, n, alpha, beta, maxDistance);
+}
+
+//! Creates a Waxman graph[Model-2] in time linear in its size.
+/**
+ * Samples the same distribution as randomWaxmanGraph(), but computes the
+ * marginal edge probability in closed form and uses geometric skipping.
+ * The cost of each edge is its distance, drawn conditioned on the edge existing.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ */
+void randomWaxmanGraphFast(EdgeSink &sink, int n, double alpha, double beta) {
+	OGDF_ASSERT(n >= 0);
+
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(alpha, beta)) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	RandomEngine rng(generatorSeed());
+	uniform_real_distribution<> dist(0, 1);
+
+	// distances are i.i.d. in [0, 1), so every pair is connected with
+	// probability alpha * integral(0, 1)(exp(-d / beta)) dd
+	double mass = 1.0 - exp(-1.0 / beta);
+	double probability = std::min(alpha * beta * mass, 1.0);
+
+	// adding n nodes to graph
+	sink.reserve(n, (long long)(probability * n * (n - 1) / 2));
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	skipPairs(n, probability, rng, [&](int v, int w) {
+		// distance conditioned on the edge has density proportional to exp(-d / beta)
+		double distance = -beta * log(1.0 - dist(rng) * mass);
+		sink.addEdge(w, v, distance);
+		probe.edges();
+	});
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Waxman graph[Model-2] in time linear in its size.
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ */
+void randomWaxmanGraphFast(Graph &G, int n, double alpha, double beta) {
+	G.clear();
+	GraphSink sink(G);
+	randomWaxmanGraphFast(sink, n, alpha, beta);
+}
+
+//! Creates a Waxman graph[Model-2] in time linear in its size and assigns edge costs.
+/**
+ * @param G is assigned the generated graph.
+ * @param cost is assigned the distance of each edge, drawn conditioned on the edge existing.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ */
+void randomWaxmanGraphFast(Graph &G, EdgeArray<double> &cost, int n, double alpha, double beta) {
+	G.clear();
+	GraphSink sink(G, &cost);
+	randomWaxmanGraphFast(sink, n, alpha, beta);
+}
+
+//! Creates a Waxman graph[Model-2] with user specified maxDistance in time linear in its size.
+/**
+ * Samples the same distribution as randomWaxmanGraphIntegral(), but computes
+ * the marginal edge probability in closed form and uses geometric skipping.
+ * The cost of each edge is its distance, drawn conditioned on the edge existing.
+ *
+ * @param sink is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param maxDistance is the maximum distance between two nodes.
+ */
+void randomWaxmanGraphIntegralFast(EdgeSink &sink, int n, double alpha, double beta, int maxDistance) {
+	OGDF_ASSERT(n >= 0 && maxDistance >= 0);
+
+	// invalid parameters yield the empty graph
+	if (n == 0 || !validParameters(alpha, beta)) {
+		sink.finish();
+		return;
+	}
+
+	GeneratorProbe probe;
+	RandomEngine rng(generatorSeed());
+	uniform_real_distribution<> dist(0, 1);
+
+	// distances are uniform in {0, ..., maxDistance}, so every pair is connected
+	// with probability alpha * summation(q^d) / (maxDistance + 1), q = exp(-1 / (beta * maxDistance))
+	double q = maxDistance == 0 ? 0.0 : exp(-1.0 / (beta * maxDistance));
+	double tail = 1.0 - pow(q, maxDistance + 1);
+	double probability = std::min(alpha * tail / ((1.0 - q) * (maxDistance + 1)), 1.0);
+
+	// adding n nodes to graph
+	sink.reserve(n, (long long)(probability * n * (n - 1) / 2));
+	for (int i = 0; i < n; i++) {
+		sink.addNode();
+	}
+
+	probe.phase(GeneratorStats::Phase::Edges);
+	skipPairs(n, probability, rng, [&](int v, int w) {
+		// distance conditioned on the edge is a truncated geometric variable
+		int distance = 0;
+		if (maxDistance > 0) {
+			distance = std::min((int)floor(log(1.0 - dist(rng) * tail) / log(q)), maxDistance);
+		}
+		sink.addEdge(w, v, distance);
+		probe.edges();
+	});
+
+	probe.phase(GeneratorStats::Phase::Finish);
+	sink.finish();
+}
+
+//! Creates a Waxman graph[Model-2] with user specified maxDistance in time linear in its size.
+/**
+ * @param G is assigned the generated graph.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param maxDistance is the maximum distance between two nodes.
+ */
+void randomWaxmanGraphIntegralFast(Graph &G, int n, double alpha, double beta, int maxDistance) {
+	G.clear();
+	GraphSink sink(G);
+	randomWaxmanGraphIntegralFast(sink, n, alpha, beta, maxDistance);
+}
+
+//! Creates a Waxman graph[Model-2] with user specified maxDistance in time linear in its size and assigns edge costs.
+/**
+ * @param G is assigned the generated graph.
+ * @param cost is assigned the distance of each edge, drawn conditioned on the edge existing.
+ * @param n is the number of nodes of the generated graph.
+ * @param alpha is a parameter in the range(0, 1].
+ * @param beta is a parameter in the range(0, 1].
+ * @param maxDistance is the maximum distance between two nodes.
+ */
+void randomWaxmanGraphIntegralFast(Graph &G, EdgeArray<int> &cost, int n, double alpha, double beta, int maxDistance) {
+	G.clear();
+	EdgeArray<double> distance;
+	GraphSink sink(G, &distance);
+	randomWaxmanGraphIntegralFast(sink, n, alpha, beta, maxDistance);
+
+	cost.init(G);
+	for (edge e : G.edges) {
+		cost[e] = (int)distance[e];
+	}
 }
 
+#ifndef OGDF_GENERATORS_LIBRARY
 int main(){
 	//! TODO: tests
 	Graph G;
@@ -234,6 +1054,11 @@ int main(){
 	randomWaxmanGraphUsingGrid(G, 100, 0.5, 0.5, 10, 10);
 	randomWaxmanGraph(G, 100, 0.5, 0.5);
 	randomWaxmanGraphIntegral(G, 100, 0.5, 0.5, 10);
+	randomWaxmanGraphUsingPlaneFast(G, 100, 0.5, 1.0);
+	randomWaxmanGraphUsingGridFast(G, 100, 0.5, 0.5, 10, 10);
+	randomWaxmanGraphFast(G, 100, 0.5, 0.5);
+	randomWaxmanGraphIntegralFast(G, 100, 0.5, 0.5, 10);
 
 	return 0;
 }
+#endif
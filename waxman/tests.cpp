@@ -1,11 +1,85 @@
+#include <functional>
+
 #include "bandit/bandit.h"
+#include "ogdf/basic/basic.h"
 #include "ogdf/basic/Graph.h"
+#include "ogdf/basic/GraphAttributes.h"
 #include "ogdf/basic/graph_generators.h"
 #include "ogdf/basic/simple_graph_alg.h"
 
+#include "../common/Generators.h"
+#include "../common/Random.h"
+#include "../tests/statistics.h"
+
 using namespace ogdf;
+using namespace ogdf::statistics;
 using namespace bandit;
 
+//! Maximum distance of the integral model.
+static const int L = 10;
+
+//! Number of samples drawn from each engine when comparing distributions.
+static const int numberOfSamples = 3000;
+
+//! Significance level of the equivalence tests.
+static const double level = 1e-3;
+
+//! Compares \p fast against the \p reference generator, both writing graphs on \p n nodes.
+static void describeEquivalence(const string &instance, int n,
+		const std::function<void(EdgeSink &)> &reference, const std::function<void(EdgeSink &)> &fast) {
+	describe(instance.c_str(), [&](){
+		GraphSamples expected = sampleGraphs(n, numberOfSamples, 4711, reference);
+		GraphSamples actual = sampleGraphs(n, numberOfSamples, 1147, fast);
+
+		it("connects every pair with the same probability", [&](){
+			AssertThat(comparePairMarginals(expected, actual), IsGreaterThan(level));
+		});
+		it("has the same degree distribution", [&](){
+			AssertThat(compareDegrees(expected, actual), IsGreaterThan(level));
+		});
+		it("has the same distribution of the number of edges", [&](){
+			AssertThat(compareEdgeCounts(expected, actual), IsGreaterThan(level));
+			AssertThat(compareMeans(expected.edges, actual.edges), IsGreaterThan(level));
+			AssertThat(compareVariances(expected.edges, actual.edges), IsGreaterThan(level));
+		});
+	});
+}
+
+//! Counting sink that also counts the calls of finish().
+class FinishCountingSink : public CountingSink {
+public:
+	int finished = 0;
+
+	void finish() override {
+		finished++;
+	}
+};
+
+//! Returns true if \p distance holds the distance between the positions in \p GA of the endpoints of every edge.
+static bool costsMatchPositions(const Graph &G, GraphAttributes &GA, const EdgeArray<double> &distance) {
+	for (edge e : G.edges) {
+		double dx = GA.x(e->source()) - GA.x(e->target());
+		double dy = GA.y(e->source()) - GA.y(e->target());
+		if (std::fabs(distance[e] - std::sqrt(dx * dx + dy * dy)) > 1e-12) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Edge list sink that also records the positions of the nodes.
+class PositionListSink : public EdgeListSink {
+public:
+	std::vector<double> positions;
+
+	using EdgeListSink::EdgeListSink;
+
+	void setPosition(int v, const double *position, int dimension) override {
+		positions.resize(std::max(positions.size(), (size_t)(v + 1) * dimension));
+		std::copy(position, position + dimension, positions.begin() + (size_t)v * dimension);
+	}
+};
+
 go_bandit([](){
 	describe("randomWaxmanGraphUsingPlane", [&](){
 		for(int n = 1; n < 100; n++) {
@@ -94,4 +168,140 @@ go_bandit([](){
 			});
 		}
 	});
+
+	describe("positions and costs", [&](){
+		using Generate = std::function<void(Graph &, GraphAttributes &, EdgeArray<double> &)>;
+		std::vector<std::pair<string, Generate>> generators = {
+			{"randomWaxmanGraphUsingPlane", [](Graph &G, GraphAttributes &GA, EdgeArray<double> &distance) {
+				randomWaxmanGraphUsingPlane(G, GA, distance, 200, 0.5, 0.2); }},
+			{"randomWaxmanGraphUsingPlaneFast", [](Graph &G, GraphAttributes &GA, EdgeArray<double> &distance) {
+				randomWaxmanGraphUsingPlaneFast(G, GA, distance, 200, 0.5, 0.2, NodeOrder::Hilbert); }},
+			{"randomWaxmanGraphUsingGrid", [](Graph &G, GraphAttributes &GA, EdgeArray<double> &distance) {
+				randomWaxmanGraphUsingGrid(G, GA, distance, 200, 0.5, 0.2, 30, 20); }},
+			{"randomWaxmanGraphUsingGridFast", [](Graph &G, GraphAttributes &GA, EdgeArray<double> &distance) {
+				randomWaxmanGraphUsingGridFast(G, GA, distance, 200, 0.5, 0.2, 30, 20, NodeOrder::Morton); }},
+		};
+		for (const auto &generator : generators) {
+			it(string("are assigned consistently by " + generator.first).c_str(), [&](){
+				Graph G;
+				GraphAttributes GA(G, GraphAttributes::nodeGraphics);
+				EdgeArray<double> distance;
+				generator.second(G, GA, distance);
+				AssertThat(G.numberOfNodes(), Equals(200));
+				AssertThat(G.numberOfEdges(), IsGreaterThan(0));
+				AssertThat(costsMatchPositions(G, GA, distance), IsTrue());
+			});
+		}
+	});
+
+	describe("randomWaxmanGraphUsingPlaneFast", [&](){
+		describeEquivalence("on 12 nodes", 12,
+			[](EdgeSink &sink) { randomWaxmanGraphUsingPlane(sink, 12, 0.6, 0.3); },
+			[](EdgeSink &sink) { randomWaxmanGraphUsingPlaneFast(sink, 12, 0.6, 0.3); });
+		describeEquivalence("on 60 nodes with a small beta", 60,
+			[](EdgeSink &sink) { randomWaxmanGraphUsingPlane(sink, 60, 0.8, 0.05); },
+			[](EdgeSink &sink) { randomWaxmanGraphUsingPlaneFast(sink, 60, 0.8, 0.05); });
+	});
+
+	describe("randomWaxmanGraphUsingGridFast", [&](){
+		describeEquivalence("on a 3x3 grid", 12,
+			[](EdgeSink &sink) { randomWaxmanGraphUsingGrid(sink, 12, 0.6, 0.3, 3, 3); },
+			[](EdgeSink &sink) { randomWaxmanGraphUsingGridFast(sink, 12, 0.6, 0.3, 3, 3); });
+		describeEquivalence("on a 20x10 grid", 12,
+			[](EdgeSink &sink) { randomWaxmanGraphUsingGrid(sink, 12, 0.6, 0.3, 20, 10); },
+			[](EdgeSink &sink) { randomWaxmanGraphUsingGridFast(sink, 12, 0.6, 0.3, 20, 10); });
+		describeEquivalence("on a 2x1 grid with many collisions", 24,
+			[](EdgeSink &sink) { randomWaxmanGraphUsingGrid(sink, 24, 0.6, 0.3, 2, 1); },
+			[](EdgeSink &sink) { randomWaxmanGraphUsingGridFast(sink, 24, 0.6, 0.3, 2, 1); });
+
+		it("connects all nodes on a single grid point with an alpha of 1", [&](){
+			Graph G;
+			randomWaxmanGraphUsingGridFast(G, 30, 1.0, 0.5, 0, 0);
+			AssertThat(G.numberOfNodes(), Equals(30));
+			AssertThat(G.numberOfEdges(), Equals(30 * 29 / 2));
+		});
+
+		it("generates the graph of the reference on a grid with more than INT_MAX points", [&](){
+			auto generate = [](void (*generator)(EdgeSink &, int, double, double, int, int, NodeOrder), PositionListSink &sink) {
+				SeedScope scope(31);
+				generator(sink, 300, 0.9, 0.5, 50000, 50000, NodeOrder::Random);
+			};
+			std::vector<std::pair<uint32_t, uint32_t>> expectedEdges, edges;
+			PositionListSink expected(expectedEdges), actual(edges);
+			generate(randomWaxmanGraphUsingGrid, expected);
+			generate(randomWaxmanGraphUsingGridFast, actual);
+
+			AssertThat(actual.positions.size(), Equals(600u));
+			AssertThat(actual.positions == expected.positions, IsTrue());
+			AssertThat(*std::max_element(actual.positions.begin(), actual.positions.end()), IsGreaterThan(40000.0));
+			AssertThat(edges.empty(), IsFalse());
+			AssertThat(edges == expectedEdges, IsTrue());
+		});
+	});
+
+	describe("randomWaxmanGraphFast", [&](){
+		describeEquivalence("on 12 nodes", 12,
+			[](EdgeSink &sink) { randomWaxmanGraph(sink, 12, 0.6, 0.3); },
+			[](EdgeSink &sink) { randomWaxmanGraphFast(sink, 12, 0.6, 0.3); });
+	});
+
+	describe("randomWaxmanGraphIntegralFast", [&](){
+		describeEquivalence("on 12 nodes", 12,
+			[](EdgeSink &sink) { randomWaxmanGraphIntegral(sink, 12, 0.6, 0.3, L); },
+			[](EdgeSink &sink) { randomWaxmanGraphIntegralFast(sink, 12, 0.6, 0.3, L); });
+	});
+
+	describe("the edge sink", [&](){
+		it("is finished exactly once, also for the empty graph", [&](){
+			for (int n : {0, 1, 40}) {
+				std::vector<std::function<void(EdgeSink &)>> generators = {
+					[n](EdgeSink &sink) { randomWaxmanGraphUsingPlane(sink, n, 0.5, 0.5); },
+					[n](EdgeSink &sink) { randomWaxmanGraphUsingPlaneFast(sink, n, 0.5, 0.5); },
+					[n](EdgeSink &sink) { randomWaxmanGraphUsingGrid(sink, n, 0.5, 0.5, 10, 10); },
+					[n](EdgeSink &sink) { randomWaxmanGraphUsingGridFast(sink, n, 0.5, 0.5, 10, 10); },
+					[n](EdgeSink &sink) { randomWaxmanGraph(sink, n, 0.5, 0.5); },
+					[n](EdgeSink &sink) { randomWaxmanGraphIntegral(sink, n, 0.5, 0.5, 100); },
+					[n](EdgeSink &sink) { randomWaxmanGraphFast(sink, n, 0.5, 0.5); },
+					[n](EdgeSink &sink) { randomWaxmanGraphIntegralFast(sink, n, 0.5, 0.5, 100); },
+				};
+				for (const auto &generate : generators) {
+					FinishCountingSink sink;
+					generate(sink);
+					AssertThat(sink.numberOfNodes(), Equals(n));
+					AssertThat(sink.finished, Equals(1));
+				}
+			}
+		});
+	});
+
+	describe("a tiny alpha", [&](){
+		// below the machine epsilon, where log(1 - alpha) rounds to 0
+		const double alpha = 1e-17;
+
+		it("yields no edges in randomWaxmanGraphUsingPlaneFast", [&](){
+			Graph G;
+			randomWaxmanGraphUsingPlaneFast(G, 2000, alpha, 0.5);
+			AssertThat(G.numberOfEdges(), Equals(0));
+			randomWaxmanGraphUsingPlaneFast(G, 2000, alpha, 0.01);
+			AssertThat(G.numberOfEdges(), Equals(0));
+		});
+
+		it("yields no edges in randomWaxmanGraphUsingGridFast", [&](){
+			Graph G;
+			randomWaxmanGraphUsingGridFast(G, 2000, alpha, 0.5, 10, 10);
+			AssertThat(G.numberOfEdges(), Equals(0));
+		});
+
+		it("yields no edges in randomWaxmanGraphFast", [&](){
+			Graph G;
+			randomWaxmanGraphFast(G, 2000, alpha, 0.5);
+			AssertThat(G.numberOfEdges(), Equals(0));
+		});
+
+		it("yields no edges in randomWaxmanGraphIntegralFast", [&](){
+			Graph G;
+			randomWaxmanGraphIntegralFast(G, 2000, alpha, 0.5, 100);
+			AssertThat(G.numberOfEdges(), Equals(0));
+		});
+	});
 });